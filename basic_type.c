@@ -55,16 +55,16 @@ long long int basic_type_get_long_long_int ( basic_type const bt ) {
  * for FLOATS
  */
 
-basic_type basic_type_long_double ( long double const long_double ) {
-  basic_type rep = { .type = t_long_double ,
-		     .value = { .val_long_double = long_double } } ;
+basic_type basic_type_float ( basic_float const f ) {
+  basic_type rep = { .type = t_float ,
+		     .value = { .val_float = f } } ;
   return rep ;
 }
 
 
-long double basic_type_get_long_double ( basic_type const bt ) {
-  assert ( t_long_double == bt . type ) ;
-  return bt . value.val_long_double ;
+basic_float basic_type_get_float ( basic_type const bt ) {
+  assert ( t_float == bt . type ) ;
+  return bt . value.val_float ;
 }
 
 
@@ -10,7 +10,7 @@
  *
  * Use
  * \li long_long_int: any integer type (including unsigned, char, size...)
- * \li long double: any float type
+ * \li basic_float: any float type (\c double, or \c long double if \c BASIC_TYPE_LONG_DOUBLE is defined at compilation)
  * \li pointer: any pointer
  * \li bool and constant basic_type_true and basic_type_false: booleans
  * \li void constant: for void (i.e. nothing)
@@ -29,18 +29,45 @@
  * \copyright GNU Public License.
  */
 
+/*!
+ * Float type of the numbers.
+ * It is \c double (fast, 8 bytes) unless \c BASIC_TYPE_LONG_DOUBLE is defined at compilation, then it is \c long double (more precise but slower and larger).
+ */
+# ifdef BASIC_TYPE_LONG_DOUBLE
+typedef long double basic_float ;
+# else
+typedef double basic_float ;
+# endif
+
+
+/*! \c printf format of a \c basic_float. */
+# ifdef BASIC_TYPE_LONG_DOUBLE
+# define BASIC_FLOAT_FORMAT "%Lf"
+# else
+# define BASIC_FLOAT_FORMAT "%f"
+# endif
+
+
+/*! Conversion of a string into a \c basic_float (as \c strtod). */
+# ifdef BASIC_TYPE_LONG_DOUBLE
+# define BASIC_FLOAT_PARSE strtold
+# else
+# define BASIC_FLOAT_PARSE strtod
+# endif
+
+
 /*!
  * Type is given otherwise direct use is impossible.
  * But it should never be accessed directly: appropriate functions should be used. 
  */
 typedef struct {
   /*! Encode the type */
-  enum { t_error, t_long_long_int , t_long_double , t_pointer, t_void , t_true , t_false
+  enum { t_error, t_long_long_int , t_float , t_pointer, t_void , t_true , t_false
   } type ;
   /*! Encode the value */
   union {
     long long int val_long_long_int ;
-    long double val_long_double ;
+    basic_float val_float ;
     void * val_pointer ;
   } value ;
 } basic_type ;
@@ -102,20 +129,20 @@ extern long long int basic_type_get_long_long_int ( basic_type const bt ) ;
 /*! 
  * Encode a float value as a \c basic_type.
  *
- * \param long_double the float to encode
+ * \param f the float to encode
  * \return basic_type encoding the float
  */
-extern basic_type basic_type_long_double ( long double const long_double ) ;
+extern basic_type basic_type_float ( basic_float const f ) ;
 
 
 /*! 
  * Recover the float encoded in a basic_type.
  *
  * \param bt basic_type representing a float
- * \pre bt must be of .type t_long_double (assert-ed)
+ * \pre bt must be of .type t_float (assert-ed)
  * \return the encoded float
  */
-extern long double basic_type_get_long_double ( basic_type const bt ) ;
+extern basic_float basic_type_get_float ( basic_type const bt ) ;
 
 
 /*! 
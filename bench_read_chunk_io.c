@@ -0,0 +1,110 @@
+# undef NDEBUG   // FORCE ASSERT ACTIVATION (before assert.h, otherwise it has no effect)
+
+# include <stdio.h>
+# include <stdlib.h>
+# include <time.h>
+# include <assert.h>
+
+# include "chunk.h"
+# include "value.h"
+# include "value_error.h"
+
+# include "input_source.h"
+# include "read_chunk_io.h"
+
+
+/*!
+ * \file
+ * \brief Throughput benchmark of the tokenizer (\link read_chunk_io() \endlink).
+ *
+ * Usage: <tt>./bench_read_chunk_io [ file [ repetitions ] ]</tt>
+ *
+ * The file is read \c repetitions times (default \link BENCH_REPETITIONS \endlink) with \c read_chunk_io and all the \c chunk's read are destroyed (nothing is evaluated).
+ * If no file is given, a data-heavy program (numbers, \c sstring's, labels and nested blocks) of about \link BENCH_GENERATED_SIZE \endlink bytes is generated in a temporary file.
+ *
+ * The throughput is printed in MB/s (processor time, as measured by \c clock).
+ *
+ * \author pf maintainers (added to the 2015 interpreter of Jérôme DURAND-LOSE)
+ * \date 2026
+ * \copyright GNU Public License.
+ */
+
+
+/*! Default number of times the file is read. */
+# define BENCH_REPETITIONS 10
+
+/*! Approximate size of the generated program. */
+# define BENCH_GENERATED_SIZE ( 16 << 20 )
+
+
+/*!
+ * Generate a data-heavy program in a temporary file.
+ *
+ * \return the temporary file, rewound, or \c NULL if it cannot be created or written
+ */
+static FILE * bench_generate ( void ) {
+  FILE * const f = tmpfile () ;
+  if ( NULL == f ) {
+    return NULL ;
+  }
+  long int size = 0 ;
+  for ( unsigned int i = 0 ; size < BENCH_GENERATED_SIZE ; i ++ ) {
+    int const written =
+      fprintf ( f , "%u -%u.%u \"some string number %u\" \\label_%u { label_%u %u \"a\\\"b\\n\" { true false } } <= != ==     \n" ,
+		i , i , i % 1000 , i , i % 97 , i % 89 , i ) ;
+    if ( written <= 0 ) {
+      fclose ( f ) ;
+      return NULL ;
+    }
+    size += written ;
+  }
+  rewind ( f ) ;
+  return f ;
+}
+
+
+/*!
+ * Read the whole stream with \c read_chunk_io and destroy the \c chunk's.
+ *
+ * \return the number of \c chunk's read
+ */
+static unsigned long int bench_read_all ( FILE * const f ) {
+  rewind ( f ) ;
+  input_source const is = input_source_create ( f ) ;
+  unsigned long int count = 0 ;
+  chunk ch ;
+  while ( ! value_is_error ( ch = read_chunk_io ( is ) ) ) {
+    chunk_destroy ( ch ) ;
+    count ++ ;
+  }
+  chunk_destroy ( ch ) ;
+  input_source_destroy ( is ) ;
+  return count ;
+}
+
+
+/*!
+ * Read the file (or a generated one) several times and print the throughput.
+ */
+int main ( int argc ,
+	   char * argv [] ) {
+  FILE * const f = ( 1 < argc ) ? fopen ( argv [ 1 ] , "r" ) : bench_generate () ;
+  if ( NULL == f ) {
+    fprintf ( stderr , "%s: cannot open %s\n" , argv [ 0 ] , ( 1 < argc ) ? argv [ 1 ] : "a temporary file" ) ;
+    return EXIT_FAILURE ;
+  }
+  unsigned int const repetitions = ( 2 < argc ) ? ( unsigned int ) atoi ( argv [ 2 ] ) : BENCH_REPETITIONS ;
+  fseek ( f , 0 , SEEK_END ) ;
+  double const size = ftell ( f ) ;
+  unsigned long int count = 0 ;
+  clock_t const start = clock () ;
+  for ( unsigned int i = 0 ; i < repetitions ; i ++ ) {
+    count = bench_read_all ( f ) ;
+  }
+  double const seconds = ( double ) ( clock () - start ) / CLOCKS_PER_SEC ;
+  fprintf ( stdout , "%.0f bytes, %lu chunks, %u repetitions, %.3f s: %.1f MB/s\n" ,
+	    size , count , repetitions , seconds ,
+	    ( 0 < seconds ) ? size * repetitions / seconds / 1e6 : 0 ) ;
+  fclose ( f ) ;
+  return EXIT_SUCCESS ;
+}
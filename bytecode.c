@@ -0,0 +1,540 @@
+# include <stdlib.h>   // malloc + free
+# include <stdbool.h>
+# include <assert.h>
+
+# include "bytecode.h"
+
+# include "value.h"
+# include "value_protected_label.h"
+# include "value_block.h"
+# include "operator.h"
+# include "chunk_stack.h"
+# include "interpreter.h"
+
+# include "operator_addition.h"
+# include "operator_subtraction.h"
+# include "operator_multiplication.h"
+# include "operator_division.h"
+# include "operator_remainder.h"
+# include "operator_less.h"
+# include "operator_less_equal.h"
+# include "operator_equal.h"
+# include "operator_different.h"
+# include "operator_and.h"
+# include "operator_or.h"
+# include "operator_not.h"
+# include "operator_nop.h"
+# include "operator_pop.h"
+# include "operator_print.h"
+# include "operator_copy.h"
+# include "operator_def.h"
+# include "operator_if.h"
+# include "operator_if_else.h"
+# include "operator_while.h"
+# include "operator_label.h"
+# include "operator_print_stack.h"
+# include "operator_print_dictionary.h"
+# include "operator_start_trace.h"
+# include "operator_stop_trace.h"
+
+
+# undef NDEBUG   // FORCE ASSERT ACTIVATION
+
+
+
+/*!
+ * \file
+ * \brief Flat code of a list of \c chunk's (run by the virtual machine of \c interpreter).
+ *
+ * Each \c chunk of the list is compiled into an instruction made of an opcode and the \c chunk itself:
+ * \li a \c value is pushed (a copy of it),
+ * \li each built-in \c operator has its own opcode (so that the virtual machine can handle the most frequent cases directly),
+ * \li any other \c operator is evaluated as usual.
+ *
+ * The instructions are stored contiguously and end with \link BYTECODE_RETURN \endlink.
+ *
+ * Constants are then folded:
+ * \li an \c operator without side effect (arithmetic, comparison, \c and, \c or, \c not) applied to literal \c value_int's or \c value_boolean's is replaced by its result (f.e. <tt>2 3 *</tt> by \c 6), unless it fails or its result is not an immediate,
+ * \li \c if and \c if_else with literal \c value_block's and a literal condition are replaced by the run of the block taken (\link BYTECODE_RUN_BLOCK \endlink) or nothing.
+ *
+ * A peephole pass then fuses frequent sequences of \c chunk's into superinstructions:
+ * \li <tt>x k + \\x def</tt> (or \c -) increments the label in place (\link BYTECODE_INCREMENT_LABEL \endlink),
+ * \li <tt>k copy</tt> copies without pushing \c k (\link BYTECODE_COPY_CONSTANT \endlink),
+ * \li <tt>k op</tt> with an arithmetic or comparison \c op applies it with the constant right operand (\link BYTECODE_OPERATION_CONSTANT \endlink),
+ * \li a comparison (with a constant or not) followed by \c if or \c if_else compares and branches (\link BYTECODE_COMPARE_IF \endlink, \link BYTECODE_COMPARE_IF_ELSE \endlink).
+ *
+ * Each instruction knows the \c chunk's it was compiled from (\c source and \c span) so that it can always be executed as these \c chunk's (f.e. to trace or when a superinstruction does not apply to the operands).
+ * The foldings and fusions can be reported with \link bytecode_trace_fusions() \endlink when they are compiled, and the number of times each superinstruction applied with \link bytecode_print_fusion_counts() \endlink.
+ *
+ * The \c chunk's are \b not copied: the list must not be modified nor destroyed as long as the \c bytecode is used.
+ * It is typically cached by \c value_block (see \link value_block_get_bytecode() \endlink).
+ *
+ * assert is enforced.
+ *
+ * \author Jérôme DURAND-LOSE
+ * \version 1
+ * \date 2015
+ * \copyright GNU Public License.
+ */
+
+
+/*!
+ * Associate an \c operator (by its test function) to its opcode.
+ */
+typedef struct {
+  bool ( * const is_operator ) ( chunk const ) ;
+  bytecode_opcode const opcode ;
+} bytecode_operator ;
+
+
+/*!
+ * To fill \link bytecode_operators \endlink.
+ */
+# define BYTECODE_OPERATOR_OPCODE( op_name , opcode_name )	\
+  { .is_operator = operator_is_ ## op_name ,			\
+    .opcode = BYTECODE_ ## opcode_name } ,
+
+
+/*!
+ * Opcodes of the built-in \c operator's (the most frequent first).
+ */
+static bytecode_operator const bytecode_operators [] = {
+  BYTECODE_OPERATOR_OPCODE ( label , LABEL )
+  BYTECODE_OPERATOR_OPCODE ( addition , ADDITION )
+  BYTECODE_OPERATOR_OPCODE ( subtraction , SUBTRACTION )
+  BYTECODE_OPERATOR_OPCODE ( multiplication , MULTIPLICATION )
+  BYTECODE_OPERATOR_OPCODE ( division , DIVISION )
+  BYTECODE_OPERATOR_OPCODE ( remainder , REMAINDER )
+  BYTECODE_OPERATOR_OPCODE ( less , LESS )
+  BYTECODE_OPERATOR_OPCODE ( less_equal , LESS_EQUAL )
+  BYTECODE_OPERATOR_OPCODE ( equal , EQUAL )
+  BYTECODE_OPERATOR_OPCODE ( different , DIFFERENT )
+  BYTECODE_OPERATOR_OPCODE ( and , AND )
+  BYTECODE_OPERATOR_OPCODE ( or , OR )
+  BYTECODE_OPERATOR_OPCODE ( not , NOT )
+  BYTECODE_OPERATOR_OPCODE ( if , IF )
+  BYTECODE_OPERATOR_OPCODE ( if_else , IF_ELSE )
+  BYTECODE_OPERATOR_OPCODE ( while , WHILE )
+  BYTECODE_OPERATOR_OPCODE ( def , DEF )
+  BYTECODE_OPERATOR_OPCODE ( copy , COPY )
+  BYTECODE_OPERATOR_OPCODE ( pop , POP )
+  BYTECODE_OPERATOR_OPCODE ( nop , NOP )
+  BYTECODE_OPERATOR_OPCODE ( print , PRINT )
+  BYTECODE_OPERATOR_OPCODE ( print_stack , PRINT_STACK )
+  BYTECODE_OPERATOR_OPCODE ( print_dictionary , PRINT_DICTIONARY )
+  BYTECODE_OPERATOR_OPCODE ( start_trace , START_TRACE )
+  BYTECODE_OPERATOR_OPCODE ( stop_trace , STOP_TRACE )
+  { .is_operator = NULL , .opcode = BYTECODE_OPERATOR }
+} ;
+
+
+/*!
+ * Opcode of a \c chunk.
+ */
+static bytecode_opcode bytecode_opcode_of ( chunk const ch ) {
+  if ( chunk_is_value ( ch ) ) {
+    return BYTECODE_PUSH ;
+  }
+  bytecode_operator const * op = bytecode_operators ;
+  while ( ( NULL != op -> is_operator ) && ! op -> is_operator ( ch ) ) {
+    op ++ ;
+  }
+  return op -> opcode ;
+}
+
+
+/*! Stream the fusions are reported to (\c NULL if they are not). */
+static FILE * bytecode_fusions_stream = NULL ;
+
+
+void bytecode_trace_fusions ( FILE * f ) {
+  bytecode_fusions_stream = f ;
+}
+
+
+/*!
+ * Report a fusion or a folding (if reporting is on): the \c chunk's compiled by \c instr and, if \c is_folded, what they are folded into.
+ * \c name is the one of the superinstruction (\c NULL for a folding).
+ */
+static void bytecode_report ( char const * const name ,
+			      bytecode_instruction const * const instr ,
+			      chunk const * const chunks ,
+			      bool const is_folded ) {
+  if ( NULL == bytecode_fusions_stream ) {
+    return ;
+  }
+  if ( is_folded ) {
+    fputs ( "==**== fold:" , bytecode_fusions_stream ) ;
+  } else {
+    fprintf ( bytecode_fusions_stream , "==**== fusion %s:" , name ) ;
+  }
+  for ( unsigned int i = 0 ; i < instr -> span ; i ++ ) {
+    fputc ( ' ' , bytecode_fusions_stream ) ;
+    chunk_print ( chunks [ instr -> source + i ] , bytecode_fusions_stream ) ;
+  }
+  if ( is_folded ) {
+    fputs ( " => " , bytecode_fusions_stream ) ;
+    if ( BYTECODE_NOP == instr -> opcode ) {
+      fputs ( "nop" , bytecode_fusions_stream ) ;
+    } else {
+      chunk_print ( instr -> ch , bytecode_fusions_stream ) ;
+    }
+  }
+  fputc ( '\n' , bytecode_fusions_stream ) ;
+}
+
+
+/*!
+ * Whether an instruction pushes an immediate (\c value_int or \c value_boolean).
+ */
+static bool bytecode_is_literal ( bytecode_instruction const * const instr ) {
+  return ( BYTECODE_PUSH == instr -> opcode ) && chunk_is_immediate ( instr -> ch ) ;
+}
+
+
+/*!
+ * Whether an instruction pushes an immediate \c value_int.
+ */
+static bool bytecode_is_int_push ( bytecode_instruction const * const instr ) {
+  return ( BYTECODE_PUSH == instr -> opcode )
+    && ( CHUNK_TAG_INT == chunk_get_tag ( instr -> ch ) ) ;
+}
+
+
+/*!
+ * Whether an instruction pushes a \c value_boolean.
+ */
+static bool bytecode_is_boolean_push ( bytecode_instruction const * const instr ) {
+  return ( BYTECODE_PUSH == instr -> opcode )
+    && ( CHUNK_TAG_BOOLEAN == chunk_get_tag ( instr -> ch ) ) ;
+}
+
+
+/*!
+ * Whether an instruction pushes a \c value_block.
+ */
+static bool bytecode_is_block_push ( bytecode_instruction const * const instr ) {
+  return ( BYTECODE_PUSH == instr -> opcode ) && value_is_block ( instr -> ch ) ;
+}
+
+
+/*!
+ * Number of operands of an \c operator without side effect (0 if the opcode is not one of them).
+ */
+static unsigned int bytecode_pure_arity ( bytecode_opcode const opcode ) {
+  switch ( opcode ) {
+  case BYTECODE_NOT :
+    return 1 ;
+  case BYTECODE_ADDITION :
+  case BYTECODE_SUBTRACTION :
+  case BYTECODE_MULTIPLICATION :
+  case BYTECODE_DIVISION :
+  case BYTECODE_REMAINDER :
+  case BYTECODE_LESS :
+  case BYTECODE_LESS_EQUAL :
+  case BYTECODE_EQUAL :
+  case BYTECODE_DIFFERENT :
+  case BYTECODE_AND :
+  case BYTECODE_OR :
+    return 2 ;
+  default :
+    return 0 ;
+  }
+}
+
+
+/*!
+ * Evaluate an \c operator without side effect on literal operands (in a scratch context).
+ * The kernels of the \c operator's check integer overflow (and division by 0), so a failed evaluation is never folded: the \c chunk's are kept and fail at run time as usual.
+ *
+ * \return the result if the evaluation succeeded and its result is an immediate (thus not a \c value_error), \c NULL otherwise
+ */
+static chunk bytecode_evaluate ( chunk const op ,
+				 bytecode_instruction const * const operands ,
+				 unsigned int const arity ) {
+  interpretation_context_struct ic = {
+    .program_input_stream = NULL ,
+    .stack = chunk_stack_create () ,
+    .dic = NULL ,
+    .do_trace = false ,
+    .use_bytecode = true ,
+    .profile = NULL ,
+    .depth = 0 ,
+    .stack_base = 0 ,
+    .stack_budget = 0 } ;
+  for ( unsigned int i = 0 ; i < arity ; i ++ ) {
+    chunk_stack_push ( ic . stack , chunk_copy ( operands [ i ] . ch ) ) ;
+  }
+  chunk result = NULL ;
+  if ( ( ! basic_type_is_error ( operator_evaluate ( op , & ic ) ) )
+       && ( 1 == chunk_stack_size ( ic . stack ) )
+       && chunk_is_immediate ( chunk_stack_peek ( ic . stack ) ) ) {
+    result = chunk_stack_pop ( ic . stack ) ;
+  }
+  chunk_stack_destroy ( ic . stack ) ;
+  return result ;
+}
+
+
+/*!
+ * Merge the last \c count instructions of \c code (ending at index \c n excluded) and the instruction \c instr that follows them into a single one.
+ *
+ * \return the merged instruction (the first of the last \c count ones)
+ */
+static bytecode_instruction * bytecode_merge ( bytecode_instruction * const code ,
+					       unsigned int const n ,
+					       unsigned int const count ,
+					       bytecode_instruction const * const instr ) {
+  bytecode_instruction * const merged = code + n - count ;
+  merged -> span = instr -> source + instr -> span - merged -> source ;
+  return merged ;
+}
+
+
+/*!
+ * Constant folding (in place): \c operator's without side effect applied to literals are replaced by their result and \c if / \c if_else with a literal condition by the branch taken.
+ * Each folded instruction still spans all the \c chunk's it replaces (so that it can be traced as them).
+ *
+ * \return the number of instructions left
+ */
+static unsigned int bytecode_fold ( bytecode_instruction * const code ,
+				    unsigned int const size ,
+				    chunk const * const chunks ) {
+  unsigned int n = 0 ;
+  for ( unsigned int i = 0 ; i < size ; i ++ ) {
+    bytecode_instruction const instr = code [ i ] ;
+    unsigned int const arity = bytecode_pure_arity ( instr . opcode ) ;
+    // literal op
+    if ( ( 0 < arity ) && ( arity <= n )
+	 && bytecode_is_literal ( code + n - 1 )
+	 && ( ( 1 == arity ) || bytecode_is_literal ( code + n - 2 ) ) ) {
+      chunk const result = bytecode_evaluate ( instr . ch , code + n - arity , arity ) ;
+      if ( NULL != result ) {
+	bytecode_instruction * const merged = bytecode_merge ( code , n , arity , & instr ) ;
+	merged -> ch = result ;
+	bytecode_report ( NULL , merged , chunks , true ) ;
+	n = n - arity + 1 ;
+	continue ;
+      }
+    }
+    // { .. } literal if
+    if ( ( BYTECODE_IF == instr . opcode ) && ( 2 <= n )
+	 && bytecode_is_boolean_push ( code + n - 1 )
+	 && bytecode_is_block_push ( code + n - 2 ) ) {
+      bool const b = basic_type_get_boolean ( value_get_value ( code [ n - 1 ] . ch ) ) ;
+      bytecode_instruction * const merged = bytecode_merge ( code , n , 2 , & instr ) ;
+      merged -> opcode = b ? BYTECODE_RUN_BLOCK : BYTECODE_NOP ;
+      bytecode_report ( NULL , merged , chunks , true ) ;
+      n = n - 1 ;
+      continue ;
+    }
+    // { .. } { .. } literal if_else
+    if ( ( BYTECODE_IF_ELSE == instr . opcode ) && ( 3 <= n )
+	 && bytecode_is_boolean_push ( code + n - 1 )
+	 && bytecode_is_block_push ( code + n - 2 )
+	 && bytecode_is_block_push ( code + n - 3 ) ) {
+      bool const b = basic_type_get_boolean ( value_get_value ( code [ n - 1 ] . ch ) ) ;
+      chunk const taken = code [ b ? n - 2 : n - 3 ] . ch ;
+      bytecode_instruction * const merged = bytecode_merge ( code , n , 3 , & instr ) ;
+      merged -> opcode = BYTECODE_RUN_BLOCK ;
+      merged -> ch = taken ;
+      bytecode_report ( NULL , merged , chunks , true ) ;
+      n = n - 2 ;
+      continue ;
+    }
+    code [ n ++ ] = instr ;
+  }
+  return n ;
+}
+
+
+/*!
+ * Whether an opcode is a comparison of integers.
+ */
+static bool bytecode_is_comparison ( bytecode_opcode const opcode ) {
+  return ( BYTECODE_LESS == opcode ) || ( BYTECODE_LESS_EQUAL == opcode )
+    || ( BYTECODE_EQUAL == opcode ) || ( BYTECODE_DIFFERENT == opcode ) ;
+}
+
+
+/*!
+ * Whether an opcode is an arithmetic operation or a comparison of integers (only an overflow can make it fail, and the VM then falls back on the \c operator).
+ */
+static bool bytecode_is_int_operation ( bytecode_opcode const opcode ) {
+  return ( BYTECODE_ADDITION == opcode ) || ( BYTECODE_SUBTRACTION == opcode )
+    || ( BYTECODE_MULTIPLICATION == opcode ) || bytecode_is_comparison ( opcode ) ;
+}
+
+
+/*!
+ * Whether an opcode is \c if or \c if_else.
+ */
+static bool bytecode_is_branch ( bytecode_opcode const opcode ) {
+  return ( BYTECODE_IF == opcode ) || ( BYTECODE_IF_ELSE == opcode ) ;
+}
+
+
+/*!
+ * Peephole: find the longest superinstruction starting at the \c i-th instruction of \c code (there are \c n of them).
+ * Only the fields specific to superinstructions are set.
+ *
+ * \return the number of instructions fused, 1 if no superinstruction applies
+ */
+static unsigned int bytecode_fuse ( bytecode_instruction const * const code ,
+				    unsigned int const i ,
+				    unsigned int const n ,
+				    bytecode_instruction * const instr ) {
+  bytecode_instruction const * const c = code + i ;
+  unsigned int const left = n - i ;
+  // x k + \x def
+  if ( ( 5 <= left )
+       && ( BYTECODE_LABEL == c [ 0 ] . opcode )
+       && bytecode_is_int_push ( c + 1 )
+       && ( ( BYTECODE_ADDITION == c [ 2 ] . opcode ) || ( BYTECODE_SUBTRACTION == c [ 2 ] . opcode ) )
+       && ( BYTECODE_PUSH == c [ 3 ] . opcode )
+       && value_is_protected_label ( c [ 3 ] . ch )
+       && ( operator_label_get_symbol ( c [ 0 ] . ch ) == value_protected_label_get_symbol ( c [ 3 ] . ch ) )
+       && ( BYTECODE_DEF == c [ 4 ] . opcode ) ) {
+    long long int const k = chunk_immediate_get_payload ( c [ 1 ] . ch ) ;
+    instr -> opcode = BYTECODE_INCREMENT_LABEL ;
+    instr -> sy = operator_label_get_symbol ( c [ 0 ] . ch ) ;
+    instr -> constant = ( BYTECODE_ADDITION == c [ 2 ] . opcode ) ? k : - k ;
+    return 5 ;
+  }
+  // k cmp if / k cmp if_else
+  if ( ( 3 <= left )
+       && bytecode_is_int_push ( c )
+       && bytecode_is_comparison ( c [ 1 ] . opcode )
+       && bytecode_is_branch ( c [ 2 ] . opcode ) ) {
+    instr -> opcode = ( BYTECODE_IF == c [ 2 ] . opcode ) ? BYTECODE_COMPARE_IF : BYTECODE_COMPARE_IF_ELSE ;
+    instr -> operation = c [ 1 ] . opcode ;
+    instr -> has_constant = true ;
+    instr -> constant = chunk_immediate_get_payload ( c [ 0 ] . ch ) ;
+    return 3 ;
+  }
+  if ( 2 <= left ) {
+    // cmp if / cmp if_else
+    if ( bytecode_is_comparison ( c [ 0 ] . opcode )
+	 && bytecode_is_branch ( c [ 1 ] . opcode ) ) {
+      instr -> opcode = ( BYTECODE_IF == c [ 1 ] . opcode ) ? BYTECODE_COMPARE_IF : BYTECODE_COMPARE_IF_ELSE ;
+      instr -> operation = c [ 0 ] . opcode ;
+      return 2 ;
+    }
+    // k op
+    if ( bytecode_is_int_push ( c )
+	 && bytecode_is_int_operation ( c [ 1 ] . opcode ) ) {
+      instr -> opcode = BYTECODE_OPERATION_CONSTANT ;
+      instr -> operation = c [ 1 ] . opcode ;
+      instr -> has_constant = true ;
+      instr -> constant = chunk_immediate_get_payload ( c [ 0 ] . ch ) ;
+      return 2 ;
+    }
+    // k copy
+    if ( bytecode_is_int_push ( c )
+	 && ( 0 <= chunk_immediate_get_payload ( c [ 0 ] . ch ) )
+	 && ( BYTECODE_COPY == c [ 1 ] . opcode ) ) {
+      instr -> opcode = BYTECODE_COPY_CONSTANT ;
+      instr -> constant = chunk_immediate_get_payload ( c [ 0 ] . ch ) ;
+      return 2 ;
+    }
+  }
+  * instr = c [ 0 ] ;
+  return 1 ;
+}
+
+
+/*!
+ * Names of the superinstructions (for \link bytecode_trace_fusions() \endlink and \link bytecode_print_fusion_counts() \endlink), \c NULL for the other opcodes.
+ */
+static char const * bytecode_fusion_name ( bytecode_opcode const opcode ) {
+  switch ( opcode ) {
+  case BYTECODE_INCREMENT_LABEL :
+    return "increment_label" ;
+  case BYTECODE_COPY_CONSTANT :
+    return "copy_constant" ;
+  case BYTECODE_OPERATION_CONSTANT :
+    return "operation_constant" ;
+  case BYTECODE_COMPARE_IF :
+    return "compare_if" ;
+  case BYTECODE_COMPARE_IF_ELSE :
+    return "compare_if_else" ;
+  default :
+    return NULL ;
+  }
+}
+
+
+unsigned long long int bytecode_fusion_counts [ BYTECODE_OPCODE_NUMBER ] = { 0 } ;
+
+
+void bytecode_print_fusion_counts ( FILE * f ) {
+  assert ( NULL != f ) ;
+  fputs ( "======== fusions applied =========\n" , f ) ;
+  fprintf ( f , "%10s  %s\n" , "runs" , "fusion" ) ;
+  for ( unsigned int opcode = 0 ; opcode < BYTECODE_OPCODE_NUMBER ; opcode ++ ) {
+    char const * const name = bytecode_fusion_name ( ( bytecode_opcode ) opcode ) ;
+    if ( NULL != name ) {
+      fprintf ( f , "%10llu  %s\n" , bytecode_fusion_counts [ opcode ] , name ) ;
+    }
+  }
+  fputs ( "==================================\n" , f ) ;
+}
+
+
+bytecode bytecode_compile ( linked_list_chunk llc ) {
+  assert ( NULL != llc ) ;
+  unsigned int size = 0 ;
+  for ( linked_list_chunk_cursor cur = linked_list_chunk_cursor_first ( llc ) ;
+	NULL != cur ;
+	cur = linked_list_chunk_cursor_next ( cur ) ) {
+    size ++ ;
+  }
+  bytecode const bc = ( bytecode ) malloc ( sizeof ( bytecode_struct ) ) ;
+  assert ( NULL != bc ) ;
+  bc -> size = size ;
+  bc -> chunks = ( chunk * ) malloc ( ( size + 1 ) * sizeof ( chunk ) ) ;
+  assert ( NULL != bc -> chunks ) ;
+  // One instruction per chunk
+  bytecode_instruction * const code = ( bytecode_instruction * ) malloc ( ( size + 1 ) * sizeof ( bytecode_instruction ) ) ;
+  assert ( NULL != code ) ;
+  unsigned int n = 0 ;
+  for ( linked_list_chunk_cursor cur = linked_list_chunk_cursor_first ( llc ) ;
+	NULL != cur ;
+	cur = linked_list_chunk_cursor_next ( cur ) , n ++ ) {
+    bc -> chunks [ n ] = linked_list_chunk_cursor_get ( cur ) ;
+    code [ n ] . opcode = bytecode_opcode_of ( bc -> chunks [ n ] ) ;
+    code [ n ] . ch = bc -> chunks [ n ] ;
+    code [ n ] . source = n ;
+    code [ n ] . span = 1 ;
+    code [ n ] . has_constant = false ;
+  }
+  n = bytecode_fold ( code , size , bc -> chunks ) ;
+  // Peephole (there are at most as many instructions as chunk's)
+  bc -> instructions = ( bytecode_instruction * ) malloc ( ( size + 1 ) * sizeof ( bytecode_instruction ) ) ;
+  assert ( NULL != bc -> instructions ) ;
+  bytecode_instruction * instr = bc -> instructions ;
+  for ( unsigned int i = 0 , fused ; i < n ; i += fused , instr ++ ) {
+    instr -> has_constant = false ;
+    fused = bytecode_fuse ( code , i , n , instr ) ;
+    if ( 1 < fused ) {
+      instr -> ch = code [ i ] . ch ;
+      instr -> source = code [ i ] . source ;
+      instr -> span = code [ i + fused - 1 ] . source + code [ i + fused - 1 ] . span - instr -> source ;
+      bytecode_report ( bytecode_fusion_name ( instr -> opcode ) , instr , bc -> chunks , false ) ;
+    }
+  }
+  instr -> opcode = BYTECODE_RETURN ;
+  instr -> ch = NULL ;
+  instr -> source = size ;
+  instr -> span = 0 ;
+  free ( code ) ;
+  return bc ;
+}
+
+
+void bytecode_destroy ( bytecode bc ) {
+  assert ( NULL != bc ) ;
+  free ( bc -> chunks ) ;
+  free ( bc -> instructions ) ;
+  free ( bc ) ;
+}
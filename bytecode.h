@@ -0,0 +1,184 @@
+# ifndef __BYTECODE_H
+# define __BYTECODE_H
+
+# include <stdio.h>
+# include <stdbool.h>
+
+# include "chunk.h"
+# include "linked_list_chunk.h"
+# include "symbol.h"
+
+
+/*!
+ * \file
+ * \brief Flat code of a list of \c chunk's (run by the virtual machine of \c interpreter).
+ *
+ * Each \c chunk of the list is compiled into an instruction made of an opcode and the \c chunk itself:
+ * \li a \c value is pushed (a copy of it),
+ * \li each built-in \c operator has its own opcode (so that the virtual machine can handle the most frequent cases directly),
+ * \li any other \c operator is evaluated as usual.
+ *
+ * The instructions are stored contiguously and end with \link BYTECODE_RETURN \endlink.
+ *
+ * Constants are then folded:
+ * \li an \c operator without side effect (arithmetic, comparison, \c and, \c or, \c not) applied to literal \c value_int's or \c value_boolean's is replaced by its result (f.e. <tt>2 3 *</tt> by \c 6), unless it fails or its result is not an immediate,
+ * \li \c if and \c if_else with literal \c value_block's and a literal condition are replaced by the run of the block taken (\link BYTECODE_RUN_BLOCK \endlink) or nothing.
+ *
+ * A peephole pass then fuses frequent sequences of \c chunk's into superinstructions:
+ * \li <tt>x k + \\x def</tt> (or \c -) increments the label in place (\link BYTECODE_INCREMENT_LABEL \endlink),
+ * \li <tt>k copy</tt> copies without pushing \c k (\link BYTECODE_COPY_CONSTANT \endlink),
+ * \li <tt>k op</tt> with an arithmetic or comparison \c op applies it with the constant right operand (\link BYTECODE_OPERATION_CONSTANT \endlink),
+ * \li a comparison (with a constant or not) followed by \c if or \c if_else compares and branches (\link BYTECODE_COMPARE_IF \endlink, \link BYTECODE_COMPARE_IF_ELSE \endlink).
+ *
+ * Each instruction knows the \c chunk's it was compiled from (\c source and \c span) so that it can always be executed as these \c chunk's (f.e. to trace or when a superinstruction does not apply to the operands).
+ * The foldings and fusions can be reported with \link bytecode_trace_fusions() \endlink when they are compiled, and the number of times each superinstruction applied with \link bytecode_print_fusion_counts() \endlink.
+ *
+ * The \c chunk's are \b not copied: the list must not be modified nor destroyed as long as the \c bytecode is used.
+ * It is typically cached by \c value_block (see \link value_block_get_bytecode() \endlink).
+ *
+ * assert is enforced.
+ *
+ * \author Jérôme DURAND-LOSE
+ * \version 1
+ * \date 2015
+ * \copyright GNU Public License.
+ */
+
+
+/*!
+ * Opcodes of the instructions.
+ */
+typedef enum {
+  BYTECODE_PUSH = 0 ,            /*!< push a copy of the \c value */
+  BYTECODE_ADDITION ,
+  BYTECODE_SUBTRACTION ,
+  BYTECODE_MULTIPLICATION ,
+  BYTECODE_DIVISION ,
+  BYTECODE_REMAINDER ,
+  BYTECODE_LESS ,
+  BYTECODE_LESS_EQUAL ,
+  BYTECODE_EQUAL ,
+  BYTECODE_DIFFERENT ,
+  BYTECODE_AND ,
+  BYTECODE_OR ,
+  BYTECODE_NOT ,
+  BYTECODE_NOP ,
+  BYTECODE_POP ,
+  BYTECODE_PRINT ,
+  BYTECODE_COPY ,
+  BYTECODE_DEF ,
+  BYTECODE_IF ,
+  BYTECODE_IF_ELSE ,
+  BYTECODE_WHILE ,
+  BYTECODE_LABEL ,
+  BYTECODE_PRINT_STACK ,
+  BYTECODE_PRINT_DICTIONARY ,
+  BYTECODE_START_TRACE ,
+  BYTECODE_STOP_TRACE ,
+  BYTECODE_OPERATOR ,            /*!< any other \c operator */
+  BYTECODE_INCREMENT_LABEL ,     /*!< <tt>x k + \\x def</tt> (superinstruction) */
+  BYTECODE_COPY_CONSTANT ,       /*!< <tt>k copy</tt> (superinstruction) */
+  BYTECODE_OPERATION_CONSTANT ,  /*!< <tt>k op</tt> (superinstruction) */
+  BYTECODE_COMPARE_IF ,          /*!< <tt>[k] cmp if</tt> (superinstruction) */
+  BYTECODE_COMPARE_IF_ELSE ,     /*!< <tt>[k] cmp if_else</tt> (superinstruction) */
+  BYTECODE_RUN_BLOCK ,           /*!< run the \c value_block (folded \c if or \c if_else) */
+  BYTECODE_RETURN ,              /*!< end of the code (there is no \c chunk) */
+  BYTECODE_OPCODE_NUMBER         /*!< number of opcodes (not an opcode) */
+} bytecode_opcode ;
+
+
+/*!
+ * An instruction.
+ *
+ * \param opcode what to do
+ * \param ch first \c chunk compiled (borrowed from the list), or the folded constant, or the \c value_block to run, \c NULL for \link BYTECODE_RETURN \endlink
+ * \param source index of the first \c chunk compiled
+ * \param span number of \c chunk's compiled (1 except for foldings and superinstructions, 0 for \link BYTECODE_RETURN \endlink)
+ * \param operation arithmetic or comparison opcode of a superinstruction
+ * \param has_constant whether the right operand of \c operation is \c constant (otherwise it is on the stack)
+ * \param constant integer constant of a superinstruction
+ * \param sy label of \link BYTECODE_INCREMENT_LABEL \endlink
+ */
+typedef struct {
+  bytecode_opcode opcode ;
+  chunk ch ;
+  unsigned int source ;
+  unsigned int span ;
+  bytecode_opcode operation ;
+  bool has_constant ;
+  long long int constant ;
+  symbol sy ;
+} bytecode_instruction ;
+
+
+/*!
+ * Compiled code.
+ *
+ * \param size number of \c chunk's compiled
+ * \param chunks the \c chunk's compiled (borrowed from the list), in order
+ * \param instructions array of instructions ending with \link BYTECODE_RETURN \endlink
+ */
+typedef struct {
+  unsigned int size ;
+  chunk * chunks ;
+  bytecode_instruction * instructions ;
+} bytecode_struct ,
+  * bytecode ;
+
+
+/*!
+ * Compile a list of \c chunk's.
+ *
+ * \param llc list to compile (not modified)
+ * \pre \c llc is not \c NULL (assert-ed)
+ * \return the code of \c llc
+ */
+extern bytecode bytecode_compile ( linked_list_chunk llc ) ;
+
+
+/*!
+ * Destroy a \c bytecode (the \c chunk's are not destroyed since they are borrowed).
+ *
+ * \param bc \c bytecode to destroy
+ * \pre \c bc is not \c NULL (assert-ed)
+ */
+extern void bytecode_destroy ( bytecode bc ) ;
+
+
+/*!
+ * Report the foldings and fusions made by \link bytecode_compile() \endlink.
+ * These are the static sites: they are reported when a \c value_block is compiled (once, however many times it is run, and even if the fused \c chunk's are never executed).
+ * Each one is printed on a line with the \c chunk's concerned as follows:
+ * \verbatim ==**== fold: 2 3 * => 6
+==**== fusion increment_label: x 1 + \x def \endverbatim
+ *
+ * \param f stream to report to, \c NULL to stop reporting
+ */
+extern void bytecode_trace_fusions ( FILE * f ) ;
+
+
+/*!
+ * Number of times each superinstruction applied, indexed by opcode (the entries of the other opcodes remain 0).
+ * It is incremented by the virtual machine when a superinstruction is executed as such, not when it falls back on its \c chunk's.
+ */
+extern unsigned long long int bytecode_fusion_counts [ BYTECODE_OPCODE_NUMBER ] ;
+
+
+/*!
+ * Print the number of times each superinstruction applied during the run (see \link bytecode_fusion_counts \endlink) as follows:
+ * \verbatim ======== fusions applied =========
+      runs  fusion
+    100000  increment_label
+         0  copy_constant
+    100001  operation_constant
+    200002  compare_if
+         0  compare_if_else
+ ================================== \endverbatim
+ *
+ * \param f stream to print to
+ * \pre \c f is not \c NULL (assert-ed)
+ */
+extern void bytecode_print_fusion_counts ( FILE * f ) ;
+
+
+# endif
@@ -15,7 +15,7 @@ basic_type chunk_answer_message ( chunk const ch ,
   assert ( NULL != ch ) ;
   assert ( NULL != message ) ;
   va_list va ;
-  message_action const * rep = ch -> reactions ;
+  message_action const * rep = chunk_header ( ch ) -> reactions ;
   // Default is message not found
   basic_type bt = basic_type_error ;
   va_start ( va , message ) ;
@@ -32,17 +32,35 @@ basic_type chunk_answer_message ( chunk const ch ,
 }
 
 
+basic_type chunk_destroy_message ( chunk const ch ,
+				   va_list va ) {
+  return ( * ( chunk_header ( ch ) -> vtable -> destroy ) ) ( ch ) ;
+}
+
+
+basic_type chunk_print_message ( chunk const ch ,
+				 va_list va ) {
+  FILE * f = va_arg ( va , FILE * ) ;
+  return ( * ( chunk_header ( ch ) -> vtable -> print ) ) ( ch , f ) ;
+}
+
+
+basic_type chunk_copy_message ( chunk const ch ,
+				va_list va ) {
+  return basic_type_pointer ( ( * ( chunk_header ( ch ) -> vtable -> copy ) ) ( ch ) ) ;
+}
+
+
 chunk chunk_copy ( chunk ch ) {
   assert ( NULL != ch ) ;
-  basic_type bt = chunk_answer_message ( ch , MESSAGE_COPY ) ;
-  return basic_type_get_pointer ( bt ) ;
+  return ( * ( chunk_header ( ch ) -> vtable -> copy ) ) ( ch ) ;
 }
 
 
 basic_type chunk_destroy ( chunk ch ) {
   return ( NULL == ch )
     ? basic_type_error
-    : chunk_answer_message ( ch , MESSAGE_DESTROY ) ;
+    : ( * ( chunk_header ( ch ) -> vtable -> destroy ) ) ( ch ) ;
 }
 
 
@@ -50,5 +68,5 @@ basic_type chunk_print ( chunk ch,
 			 FILE * f ) {
   assert ( NULL != ch ) ;
   assert ( NULL != f ) ;
-  return chunk_answer_message ( ch , MESSAGE_PRINT , f ) ;
+  return ( * ( chunk_header ( ch ) -> vtable -> print ) ) ( ch , f ) ;
 }
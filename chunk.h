@@ -3,6 +3,7 @@
 
 # include <stdarg.h>
 # include <stdio.h>
+# include <stdint.h>
 
 # include "basic_type.h"
 
@@ -24,6 +25,14 @@
  * Destroying an instance or a copy does not destroy the other.
  * This also implies that both should be destroyed before the programs finished.
  *
+ * These \em methods (and the ones of \c value and \c operator) are also gathered in a typed table, a \c chunk_vtable, one per class.
+ * \c chunk_destroy, \c chunk_copy, \c chunk_print (and \c value_get_value, \c operator_evaluate) go directly through it: a single indirect call, no string comparison and no \c va_list.
+ * The ( message , action ) listing is still answered (through the table) and remains available for any other message.
+ *
+ * A \c chunk is not always a pointer: small scalar \c value's are \em immediate, i.e. encoded directly in the handle (see \link chunk_tag \endlink).
+ * They have no \c chunk_struct and need no allocation; their \c copy and \c destroy do nothing.
+ * This is why the fields of a \c chunk_struct should only be accessed through \link chunk_header \endlink unless the \c chunk is known to be a pointer.
+ *
  * In each module, a function should be provided to test the nature of the \c chunk.
  * Its name is of the form:
  * \li \c chunk_is_XXX
@@ -44,6 +53,9 @@
 // Indicate its existence for next declaration.
 struct chunk_struct ;    
 
+// Defined in interpreter.h, only needed for the type of operator evaluation.
+struct interpretation_context_struct ;
+
 /*!
  * Structure used to store a pair ( receivable message, associated action ) to define a \em method.
  *
@@ -58,20 +70,108 @@ typedef struct {
 
 
 
+/*!
+ * Typed table of the \em methods of a class.
+ * There is only one (constant) table for each class and all its instances point to it.
+ *
+ * Entries that do not make sense for a class are left \c NULL (f.e. \c evaluate for a \c value).
+ *
+ * \param destroy same as \c "destroy"
+ * \param print same as \c "print"
+ * \param copy same as \c "copy" but the copy is directly returned
+ * \param get_value same as \c "value_get_value" (only for \c value's)
+ * \param evaluate same as \c "operator_evaluate" (only for \c operator's)
+ */
+typedef struct {
+  basic_type ( * const destroy ) ( struct chunk_struct * const ) ;
+  basic_type ( * const print ) ( struct chunk_struct * const ,
+				 FILE * const ) ;
+  struct chunk_struct * ( * const copy ) ( struct chunk_struct * const ) ;
+  basic_type ( * const get_value ) ( struct chunk_struct * const ) ;
+  basic_type ( * const evaluate ) ( struct chunk_struct * const ,
+				    struct interpretation_context_struct * const ) ;
+} chunk_vtable ;
+
+
+
 /*!
  * Structure used to define an instance of an \c chunk.
  *
  * \param reactions regroups the definition of the methods
+ * \param vtable typed table of the methods (hot path)
  * \param state stores the data for the instance
  */
 // Type provided to allow other modules to define chunks
 typedef struct chunk_struct {
   message_action const * reactions ;
+  chunk_vtable const * vtable ;
   void * state ;
 } chunk_struct ,
   * chunk ;  
 
 
+/*!
+ * Tags stored in the low bits of a \c chunk.
+ * \li \c CHUNK_TAG_POINTER: the \c chunk is a pointer to a \c chunk_struct (allocation ensures the low bits are 0)
+ * \li otherwise the \c chunk is an \em immediate, the rest of the bits is its payload.
+ */
+typedef enum {
+  CHUNK_TAG_POINTER = 0 ,
+  CHUNK_TAG_INT = 1 ,
+  CHUNK_TAG_BOOLEAN = 2
+} chunk_tag ;
+
+
+/*! Number of low bits of a \c chunk used by the tag. */
+# define CHUNK_TAG_BITS 2
+
+/*! Mask to extract the tag of a \c chunk. */
+# define CHUNK_TAG_MASK ( ( ( uintptr_t ) 1 << CHUNK_TAG_BITS ) - 1 )
+
+/*! Smallest payload that an immediate can hold. */
+# define CHUNK_IMMEDIATE_MIN ( INTPTR_MIN >> CHUNK_TAG_BITS )
+
+/*! Largest payload that an immediate can hold. */
+# define CHUNK_IMMEDIATE_MAX ( INTPTR_MAX >> CHUNK_TAG_BITS )
+
+
+/*! Tag of a \c chunk. */
+# define chunk_get_tag( ch )					\
+  ( ( chunk_tag ) ( ( uintptr_t ) ( ch ) & CHUNK_TAG_MASK ) )
+
+/*! Test whether a \c chunk is an immediate (i.e. not a pointer). */
+# define chunk_is_immediate( ch )			\
+  ( CHUNK_TAG_POINTER != chunk_get_tag ( ch ) )
+
+/*!
+ * Build an immediate.
+ * The payload must be between \c CHUNK_IMMEDIATE_MIN and \c CHUNK_IMMEDIATE_MAX.
+ */
+# define chunk_immediate_create( tag , payload )				\
+  ( ( chunk ) ( ( ( uintptr_t ) ( intptr_t ) ( payload ) << CHUNK_TAG_BITS ) | ( tag ) ) )
+
+/*! Payload of an immediate (the shift is arithmetic so that the sign is restored). */
+# define chunk_immediate_get_payload( ch )		\
+  ( ( intptr_t ) ( ch ) >> CHUNK_TAG_BITS )
+
+
+/*!
+ * For each tag, a \c chunk_struct (without \c state) giving the \c reactions and \c vtable of the class of the immediates with this tag.
+ * Entry for \c CHUNK_TAG_POINTER is \c NULL.
+ * It is defined in \link value.c \endlink since all immediates are \c value's.
+ */
+extern chunk_struct const * const chunk_immediate_class [] ;
+
+
+/*!
+ * The \c chunk_struct giving \c reactions and \c vtable of any \c chunk: the \c chunk itself or the one of its class if it is an immediate.
+ */
+# define chunk_header( ch )					\
+  ( chunk_is_immediate ( ch )					\
+    ? chunk_immediate_class [ chunk_get_tag ( ch ) ]		\
+    : ( chunk_struct const * ) ( ch ) )
+
+
 /*! 
  * Send a message to a \c chunk. 
  * If the message corresponds to a \em method, it is activated and the basic_type it returns is returned.
@@ -90,7 +190,7 @@ extern basic_type chunk_answer_message ( chunk const ch ,
 
 /*! 
  * Destroy a \c chunk and release all associated ressources.
- * It invokes the \em method \c "destroy".
+ * It invokes the \em method \c "destroy" directly from the \c chunk_vtable.
  *
  * \param ch \c chunk to destroy
  * \pre \c ch is not \c NULL (assert-ed)
@@ -101,7 +201,7 @@ extern basic_type chunk_destroy ( chunk ch ) ;
 
 /*! 
  * provide a copy of a \c chunk.
- * It invokes the method \c "copy".
+ * It invokes the \em method \c "copy" directly from the \c chunk_vtable.
  *
  * \param ch \c chunk to copy
  * \pre \c ch is not \c NULL (assert-ed)
@@ -112,7 +212,7 @@ extern chunk chunk_copy ( chunk ch ) ;
 
 /*! 
  * Print the chunk to the designated \c FILE \c *.
- * It invokes the method \c "print".
+ * It invokes the \em method \c "print" directly from the \c chunk_vtable.
  *
  * \param ch \c chunk to print
  * \param f stream to print to
@@ -134,25 +234,70 @@ extern basic_type chunk_print ( chunk ch ,
 # define MESSAGE_PRINT "print" 
 
 
+/*!
+ * Action for \link MESSAGE_DESTROY \endlink: forwards to the \c destroy entry of the \c chunk_vtable.
+ * It is shared by all classes.
+ */
+extern basic_type chunk_destroy_message ( chunk const ch ,
+					  va_list va ) ;
+
+
+/*!
+ * Action for \link MESSAGE_PRINT \endlink: forwards to the \c print entry of the \c chunk_vtable.
+ * The stream is the extra argument.
+ * It is shared by all classes.
+ */
+extern basic_type chunk_print_message ( chunk const ch ,
+					va_list va ) ;
+
+
+/*!
+ * Action for \link MESSAGE_COPY \endlink: forwards to the \c copy entry of the \c chunk_vtable.
+ * It is shared by all classes.
+ *
+ * \return the copy as a \c basic_type pointer
+ */
+extern basic_type chunk_copy_message ( chunk const ch ,
+				       va_list va ) ;
+
+
 /*! 
  * Generated the action listing for \em methods that \em must be present in any \c chunk.
+ * The actions only forward to the \c chunk_vtable of the \c chunk, so that the listing is the same for all classes.
+ */ 
+# define MESSAGE_ACTION__BASIC				\
+  { MESSAGE_DESTROY , & chunk_destroy_message } ,	\
+  { MESSAGE_PRINT , & chunk_print_message } ,		\
+  { MESSAGE_COPY , & chunk_copy_message } 
+
+
+/*! 
+ * Generate the action listing for chunk that are not in any special sub-classification.
+ */ 
+# define MESSAGE_ACTION__BASIC_CHUNK		\
+  MESSAGE_ACTION__BASIC
+
+
+/*! 
+ * Generated the \c chunk_vtable entries for \em methods that \em must be present in any \c chunk.
+ * The functions <tt>chunk_ ## type ## _destroy</tt>, <tt>…_print</tt> and <tt>…_copy</tt> must be defined with the typed signatures.
  *
  * \param chunk_ is the base name, to be changed to reflect \em class \em hierarchies (f.e. value and operator)
  * \param type to indicate the proper name of the chunk type
  */ 
-# define MESSAGE_ACTION__BASIC_PARAM( chunk_ , type )	\
-  { MESSAGE_DESTROY , & chunk_ ## type ## _destroy } ,	\
-  { MESSAGE_PRINT , & chunk_ ## type ## _print } ,	\
-  { MESSAGE_COPY , & chunk_ ## type ## _copy } 
+# define CHUNK_VTABLE__BASIC_PARAM( chunk_ , type )	\
+  .destroy = & chunk_ ## type ## _destroy ,		\
+  .print = & chunk_ ## type ## _print ,			\
+  .copy = & chunk_ ## type ## _copy
 
 
 /*! 
- * Generate the action listing for chunk that are not in any special sub-classification.
+ * Generate the \c chunk_vtable entries for chunk that are not in any special sub-classification.
  *
  * \param type to indicate the proper name of the chunk type
  */ 
-# define MESSAGE_ACTION__BASIC_CHUNK( type )  \
-  MESSAGE_ACTION__BASIC_PARAM( chunk_ , type )
+# define CHUNK_VTABLE__BASIC_CHUNK( type )	\
+  CHUNK_VTABLE__BASIC_PARAM( chunk_ , type )
 
 
 # endif
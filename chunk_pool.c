@@ -0,0 +1,217 @@
+# include <stdlib.h>   // malloc + free + atexit
+# include <stdbool.h>
+# include <assert.h>
+
+# include "chunk_pool.h"
+
+
+# undef NDEBUG   // FORCE ASSERT ACTIVATION
+
+
+
+/*!
+ * \file
+ * \brief Allocator for \c chunk's with a state.
+ *
+ * The \c chunk_struct and its state are allocated as a single block: the state is located right after the (aligned) \c chunk_struct.
+ * Blocks are taken from pools, one per size class (multiple of \link CHUNK_POOL_GRANULARITY\endlink).
+ * Each pool carves its blocks from large slabs and recycles released blocks through a free list.
+ * So that, in steady state, creating and destroying a \c value does not call \c malloc nor \c free and instances of the same size are close in memory.
+ *
+ * Blocks larger than the last size class are directly \c malloc-ed.
+ *
+ * Slabs are only released at exit (registered with \c atexit).
+ * All blocks must have been released by then (assert-ed), so that a leak of \c chunk's is detected even though the slabs are freed.
+ *
+ * If \c CHUNK_POOL_NO_POOL is defined at compilation, blocks are directly \c malloc-ed and \c free-ed.
+ * This should be used to locate memory leaks (f.e. with \c valgrind) since, otherwise, unreleased blocks are only counted.
+ *
+ * assert is enforced.
+ *
+ * \author Jérôme DURAND-LOSE
+ * \version 1
+ * \date 2015
+ * \copyright GNU Public License.
+ */
+
+
+/*!
+ * Beginning of a block: the \c chunk_struct padded so that the state that follows is aligned for any type.
+ */
+typedef union {
+  chunk_struct ch ;
+  basic_float floating ;
+  long long int long_long_int ;
+  void * pointer ;
+} chunk_pool_header ;
+
+
+/*!
+ * A released block is kept in the free list of its size class.
+ */
+typedef struct free_block_struct {
+  struct free_block_struct * next ;
+} free_block ;
+
+
+/*!
+ * Beginning of a slab, slabs are chained to be released at exit.
+ * The blocks follow.
+ */
+typedef union slab_union {
+  union slab_union * next ;
+  chunk_pool_header alignment ;
+} slab ;
+
+
+/*!
+ * A size class: its free list and its counters.
+ */
+typedef struct {
+  free_block * free_list ;
+  chunk_pool_statistics statistics ;
+} size_class ;
+
+
+/*! All size classes, the extra last one is for oversized (non pooled) blocks. */
+static size_class chunk_pool_size_classes [ CHUNK_POOL_CLASS_NUMBER + 1 ] ;
+
+/*! All the slabs ever allocated. */
+static slab * chunk_pool_slabs = NULL ;
+
+
+/*!
+ * Index of the size class for a given state size.
+ */
+static unsigned int chunk_pool_class_index ( size_t const state_size ) {
+  size_t const blocks = ( sizeof ( chunk_pool_header ) + state_size + CHUNK_POOL_GRANULARITY - 1 )
+    / CHUNK_POOL_GRANULARITY ;
+  return ( blocks <= CHUNK_POOL_CLASS_NUMBER )
+    ? blocks - 1
+    : CHUNK_POOL_CLASS_NUMBER ;
+}
+
+
+/*!
+ * Release all slabs (registered with \c atexit).
+ * Every block must have been released before (assert-ed): since the slabs are freed anyway, a memory checker could not report the leak otherwise.
+ */
+static void chunk_pool_release_slabs ( void ) {
+  for ( unsigned int i = 0 ; i <= CHUNK_POOL_CLASS_NUMBER ; i ++ ) {
+    assert ( 0 == chunk_pool_size_classes [ i ] . statistics . in_use ) ;
+  }
+  while ( NULL != chunk_pool_slabs ) {
+    slab * const next = chunk_pool_slabs -> next ;
+    free ( chunk_pool_slabs ) ;
+    chunk_pool_slabs = next ;
+  }
+  for ( unsigned int i = 0 ; i < CHUNK_POOL_CLASS_NUMBER ; i ++ ) {
+    chunk_pool_size_classes [ i ] . free_list = NULL ;
+  }
+}
+
+
+/*!
+ * Carve a new slab for a size class and add all its blocks to the free list.
+ */
+static void chunk_pool_add_slab ( size_class * const sc ,
+				  size_t const block_size ) {
+  if ( NULL == chunk_pool_slabs ) {
+    atexit ( & chunk_pool_release_slabs ) ;
+  }
+  slab * const sl = ( slab * ) malloc ( sizeof ( slab ) + CHUNK_POOL_SLAB_BLOCKS * block_size ) ;
+  assert ( NULL != sl ) ;
+  sl -> next = chunk_pool_slabs ;
+  chunk_pool_slabs = sl ;
+  char * block = ( char * ) ( sl + 1 ) ;
+  for ( unsigned int i = 0 ; i < CHUNK_POOL_SLAB_BLOCKS ; i ++ , block += block_size ) {
+    ( ( free_block * ) block ) -> next = sc -> free_list ;
+    sc -> free_list = ( free_block * ) block ;
+  }
+}
+
+
+chunk chunk_pool_allocate ( message_action const * const reactions ,
+			    chunk_vtable const * const vtable ,
+			    size_t const state_size ) {
+  assert ( NULL != reactions ) ;
+  assert ( NULL != vtable ) ;
+  unsigned int const index = chunk_pool_class_index ( state_size ) ;
+  size_class * const sc = chunk_pool_size_classes + index ;
+  chunk_pool_header * block ;
+# ifdef CHUNK_POOL_NO_POOL
+  sc -> statistics . misses ++ ;
+  block = ( chunk_pool_header * ) malloc ( sizeof ( chunk_pool_header ) + state_size ) ;
+# else
+  if ( CHUNK_POOL_CLASS_NUMBER == index ) {
+    sc -> statistics . misses ++ ;
+    block = ( chunk_pool_header * ) malloc ( sizeof ( chunk_pool_header ) + state_size ) ;
+  } else {
+    if ( NULL == sc -> free_list ) {
+      sc -> statistics . misses ++ ;
+      chunk_pool_add_slab ( sc , ( index + 1 ) * CHUNK_POOL_GRANULARITY ) ;
+    } else {
+      sc -> statistics . hits ++ ;
+    }
+    block = ( chunk_pool_header * ) sc -> free_list ;
+    sc -> free_list = sc -> free_list -> next ;
+  }
+# endif
+  assert ( NULL != block ) ;
+  sc -> statistics . in_use ++ ;
+  chunk const ch = & ( block -> ch ) ;
+  ch -> reactions = reactions ;
+  ch -> vtable = vtable ;
+  ch -> state = ( 0 == state_size ) ? NULL : ( void * ) ( block + 1 ) ;
+  return ch ;
+}
+
+
+void chunk_pool_release ( chunk const ch ,
+			  size_t const state_size ) {
+  assert ( NULL != ch ) ;
+  assert ( ! chunk_is_immediate ( ch ) ) ;
+  unsigned int const index = chunk_pool_class_index ( state_size ) ;
+  size_class * const sc = chunk_pool_size_classes + index ;
+  assert ( 0 < sc -> statistics . in_use ) ;
+  sc -> statistics . in_use -- ;
+  ch -> reactions = NULL ;
+  ch -> vtable = NULL ;
+  ch -> state = NULL ;
+# ifdef CHUNK_POOL_NO_POOL
+  free ( ch ) ;
+# else
+  if ( CHUNK_POOL_CLASS_NUMBER == index ) {
+    free ( ch ) ;
+  } else {
+    ( ( free_block * ) ch ) -> next = sc -> free_list ;
+    sc -> free_list = ( free_block * ) ch ;
+  }
+# endif
+}
+
+
+chunk_pool_statistics chunk_pool_get_statistics ( size_t const state_size ) {
+  unsigned int const index = chunk_pool_class_index ( state_size ) ;
+  chunk_pool_statistics st = chunk_pool_size_classes [ index ] . statistics ;
+  st . size = ( CHUNK_POOL_CLASS_NUMBER == index )
+    ? 0
+    : ( index + 1 ) * CHUNK_POOL_GRANULARITY ;
+  return st ;
+}
+
+
+void chunk_pool_print_statistics ( FILE * const f ) {
+  assert ( NULL != f ) ;
+  for ( unsigned int i = 0 ; i <= CHUNK_POOL_CLASS_NUMBER ; i ++ ) {
+    chunk_pool_statistics const * const st = & ( chunk_pool_size_classes [ i ] . statistics ) ;
+    if ( 0 != st -> hits + st -> misses ) {
+      if ( CHUNK_POOL_CLASS_NUMBER == i ) {
+	fprintf ( f , "chunk_pool [ oversized ]" ) ;
+      } else {
+	fprintf ( f , "chunk_pool [ %4u bytes ]" , ( i + 1 ) * CHUNK_POOL_GRANULARITY ) ;
+      }
+      fprintf ( f , " hits: %llu misses: %llu in use: %llu\n" , st -> hits , st -> misses , st -> in_use ) ;
+    }
+  }
+}
@@ -0,0 +1,107 @@
+# ifndef __CHUNK_POOL_H
+# define __CHUNK_POOL_H
+
+# include <stddef.h>
+# include <stdio.h>
+
+# include "chunk.h"
+
+
+/*!
+ * \file
+ * \brief Allocator for \c chunk's with a state.
+ *
+ * The \c chunk_struct and its state are allocated as a single block: the state is located right after the (aligned) \c chunk_struct.
+ * Blocks are taken from pools, one per size class (multiple of \link CHUNK_POOL_GRANULARITY\endlink).
+ * Each pool carves its blocks from large slabs and recycles released blocks through a free list.
+ * So that, in steady state, creating and destroying a \c value does not call \c malloc nor \c free and instances of the same size are close in memory.
+ *
+ * Blocks larger than the last size class are directly \c malloc-ed.
+ *
+ * Slabs are only released at exit (registered with \c atexit).
+ * All blocks must have been released by then (assert-ed), so that a leak of \c chunk's is detected even though the slabs are freed.
+ *
+ * If \c CHUNK_POOL_NO_POOL is defined at compilation, blocks are directly \c malloc-ed and \c free-ed.
+ * This should be used to locate memory leaks (f.e. with \c valgrind) since, otherwise, unreleased blocks are only counted.
+ *
+ * assert is enforced.
+ *
+ * \author Jérôme DURAND-LOSE
+ * \version 1
+ * \date 2015
+ * \copyright GNU Public License.
+ */
+
+
+/*! Size classes are multiple of this size (in bytes). */
+# define CHUNK_POOL_GRANULARITY 16
+
+/*! Number of size classes. Larger blocks are not pooled. */
+# define CHUNK_POOL_CLASS_NUMBER 16
+
+/*! Number of blocks in a slab. */
+# define CHUNK_POOL_SLAB_BLOCKS 128
+
+
+/*!
+ * Counters for a size class.
+ *
+ * \param size size of the blocks of the class (\c chunk_struct included)
+ * \param hits number of allocations served from the free list
+ * \param misses number of allocations that needed a new slab (or a \c malloc if not pooled)
+ * \param in_use number of blocks currently allocated
+ */
+typedef struct {
+  size_t size ;
+  unsigned long long int hits ;
+  unsigned long long int misses ;
+  unsigned long long int in_use ;
+} chunk_pool_statistics ;
+
+
+/*!
+ * Allocate a \c chunk together with its state.
+ *
+ * \param reactions set as \c reactions of the \c chunk
+ * \param vtable set as \c vtable of the \c chunk
+ * \param state_size size of the state (0 for no state)
+ * \pre \c reactions and \c vtable are not \c NULL (assert-ed)
+ * \return a \c chunk whose \c state points to \c state_size uninitialized bytes (\c NULL if \c state_size is 0)
+ */
+extern chunk chunk_pool_allocate ( message_action const * const reactions ,
+				   chunk_vtable const * const vtable ,
+				   size_t const state_size ) ;
+
+
+/*!
+ * Release a \c chunk allocated with \link chunk_pool_allocate() \endlink.
+ * Its state is released with it (there must be no separate \c free).
+ *
+ * \param ch \c chunk to release
+ * \param state_size size of the state given on allocation
+ * \pre \c ch is not \c NULL nor an immediate (assert-ed)
+ */
+extern void chunk_pool_release ( chunk const ch ,
+				 size_t const state_size ) ;
+
+
+/*!
+ * Get the counters of the size class used for a state size.
+ * Oversized states all share the same counters.
+ *
+ * \param state_size size of the state
+ * \return copy of the counters
+ */
+extern chunk_pool_statistics chunk_pool_get_statistics ( size_t const state_size ) ;
+
+
+/*!
+ * Print the counters of all the size classes that have been used, one per line.
+ *
+ * \param f stream to print to
+ * \pre \c f is not \c NULL (assert-ed)
+ */
+extern void chunk_pool_print_statistics ( FILE * const f ) ;
+
+
+# endif
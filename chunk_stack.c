@@ -0,0 +1,161 @@
+# include <stdlib.h>   // malloc + realloc + free
+# include <stdbool.h>
+# include <assert.h>
+
+# include "chunk_stack.h"
+
+
+# undef NDEBUG   // FORCE ASSERT ACTIVATION
+
+
+
+/*!
+ * \file
+ * \brief Stack of \link chunk\endlink 's (used as the interpretation stack).
+ *
+ * Please note that \c chunk_stack does not make any copy of \c chunk's (except for \link chunk_stack_dup_n() \endlink).
+ *
+ * The \c chunk's are stored contiguously in an array that grows geometrically (it is never shrunk).
+ * Pushing and popping are thus O(1) and do not allocate once the array is large enough.
+ * Any element can be accessed by its depth in O(1).
+ *
+ * assert is enforced.
+ *
+ * \author Jérôme DURAND-LOSE
+ * \version 1
+ * \date 2015
+ * \copyright GNU Public License.
+ */
+
+
+/*! Initial capacity of the array. */
+# define CHUNK_STACK_INITIAL_CAPACITY 64
+
+
+/*!
+ * The bottom of the stack is at index 0, the top at index <tt>size - 1</tt>.
+ *
+ * \param chunks array of the \c chunk's
+ * \param size number of \c chunk's in the stack
+ * \param capacity size of the array
+ */
+struct chunk_stack_struct {
+  chunk * chunks ;
+  unsigned int size ;
+  unsigned int capacity ;
+} ;
+
+
+/*!
+ * Ensure that the array can hold at least \c size \c chunk's (doubling the capacity as needed).
+ */
+static void chunk_stack_reserve ( chunk_stack cs ,
+				  unsigned int const size ) {
+  if ( size <= cs -> capacity ) {
+    return ;
+  }
+  unsigned int capacity = cs -> capacity ;
+  while ( capacity < size ) {
+    capacity *= 2 ;
+  }
+  cs -> chunks = ( chunk * ) realloc ( cs -> chunks , capacity * sizeof ( chunk ) ) ;
+  assert ( NULL != cs -> chunks ) ;
+  cs -> capacity = capacity ;
+}
+
+
+chunk_stack chunk_stack_create ( void ) {
+  chunk_stack cs = ( chunk_stack ) malloc ( sizeof ( struct chunk_stack_struct ) ) ;
+  assert ( NULL != cs ) ;
+  cs -> chunks = ( chunk * ) malloc ( CHUNK_STACK_INITIAL_CAPACITY * sizeof ( chunk ) ) ;
+  assert ( NULL != cs -> chunks ) ;
+  cs -> size = 0 ;
+  cs -> capacity = CHUNK_STACK_INITIAL_CAPACITY ;
+  return cs ;
+}
+
+
+void chunk_stack_destroy ( chunk_stack cs ) {
+  assert ( NULL != cs ) ;
+  while ( 0 < cs -> size ) {
+    chunk_destroy ( cs -> chunks [ -- ( cs -> size ) ] ) ;
+  }
+  free ( cs -> chunks ) ;
+  free ( cs ) ;
+}
+
+
+bool chunk_stack_is_empty ( chunk_stack cs ) {
+  assert ( NULL != cs ) ;
+  return 0 == cs -> size ;
+}
+
+
+unsigned int chunk_stack_size ( chunk_stack cs ) {
+  assert ( NULL != cs ) ;
+  return cs -> size ;
+}
+
+
+void chunk_stack_print ( chunk_stack cs ,
+			 FILE * f ) {
+  assert ( NULL != cs ) ;
+  assert ( NULL != f ) ;
+  for ( unsigned int i = cs -> size ; 0 < i ; i -- ) {
+    chunk_print ( cs -> chunks [ i - 1 ] , f ) ;
+    fputc ( '\n' , f ) ;
+  }
+}
+
+
+void chunk_stack_push ( chunk_stack cs ,
+			chunk ch ) {
+  assert ( NULL != cs ) ;
+  assert ( NULL != ch ) ;
+  if ( cs -> size == cs -> capacity ) {
+    chunk_stack_reserve ( cs , cs -> size + 1 ) ;
+  }
+  cs -> chunks [ cs -> size ++ ] = ch ;
+}
+
+
+chunk chunk_stack_pop ( chunk_stack cs ) {
+  assert ( NULL != cs ) ;
+  return ( 0 == cs -> size )
+    ? NULL
+    : cs -> chunks [ -- ( cs -> size ) ] ;
+}
+
+
+chunk chunk_stack_peek ( chunk_stack cs ) {
+  assert ( NULL != cs ) ;
+  return ( 0 == cs -> size )
+    ? NULL
+    : cs -> chunks [ cs -> size - 1 ] ;
+}
+
+
+chunk chunk_stack_nth ( chunk_stack cs ,
+			unsigned int n ) {
+  assert ( NULL != cs ) ;
+  return ( cs -> size <= n )
+    ? NULL
+    : cs -> chunks [ cs -> size - 1 - n ] ;
+}
+
+
+bool chunk_stack_dup_n ( chunk_stack cs ,
+			 unsigned int k ) {
+  assert ( NULL != cs ) ;
+  if ( cs -> size < k ) {
+    return false ;
+  }
+  chunk_stack_reserve ( cs , cs -> size + k ) ;
+  chunk const * const src = cs -> chunks + cs -> size - k ;
+  chunk * const dst = cs -> chunks + cs -> size ;
+  for ( unsigned int i = 0 ; i < k ; i ++ ) {
+    dst [ i ] = chunk_copy ( src [ i ] ) ;
+  }
+  cs -> size += k ;
+  return true ;
+}
@@ -0,0 +1,150 @@
+# ifndef __CHUNK_STACK_H
+# define __CHUNK_STACK_H
+
+# include <stdbool.h>
+# include <stdio.h>
+
+# include "chunk.h"
+
+
+/*!
+ * \file
+ * \brief Stack of \link chunk\endlink 's (used as the interpretation stack).
+ *
+ * Please note that \c chunk_stack does not make any copy of \c chunk's (except for \link chunk_stack_dup_n() \endlink).
+ *
+ * The \c chunk's are stored contiguously in an array that grows geometrically (it is never shrunk).
+ * Pushing and popping are thus O(1) and do not allocate once the array is large enough.
+ * Any element can be accessed by its depth in O(1).
+ *
+ * assert is enforced.
+ *
+ * \author Jérôme DURAND-LOSE
+ * \version 1
+ * \date 2015
+ * \copyright GNU Public License.
+ */
+
+
+/*!
+ * \c chunk_stack is a pointer to a hidden structure.
+ */
+typedef struct chunk_stack_struct * chunk_stack ;
+
+
+/*!
+ * Generate an empty \c chunk_stack.
+ *
+ * \return an empty \c chunk_stack
+ */
+extern chunk_stack chunk_stack_create ( void ) ;
+
+
+/*!
+ * Destroy the whole structure and the stored \c chunk's.
+ *
+ * \param cs \c chunk_stack to destroy
+ * \pre \c cs is valid (assert-ed)
+ */
+extern void chunk_stack_destroy ( chunk_stack cs ) ;
+
+
+/*!
+ * To know whether a \c chunk_stack is empty.
+ *
+ * \param cs \c chunk_stack to test
+ * \pre \c cs is valid (assert-ed)
+ * \return true iff \c cs is empty
+ */
+extern bool chunk_stack_is_empty ( chunk_stack cs ) ;
+
+
+/*!
+ * Number of \c chunk's in a \c chunk_stack.
+ *
+ * \param cs \c chunk_stack to query
+ * \pre \c cs is valid (assert-ed)
+ * \return the number of \c chunk's
+ */
+extern unsigned int chunk_stack_size ( chunk_stack cs ) ;
+
+
+/*!
+ * Print a \c chunk_stack from top to bottom.
+ * Each chunk is printed on a separate line with \c chunk_print.
+ *
+ * \param cs \c chunk_stack to print
+ * \param f stream to print to
+ * \pre \c cs is valid (assert-ed)
+ * \pre \c f is not \c NULL (assert-ed)
+ */
+extern void chunk_stack_print ( chunk_stack cs ,
+				FILE * f ) ;
+
+
+/*!
+ * Add a \c chunk on top of the \c chunk_stack.
+ *
+ * \param cs \c chunk_stack to add to
+ * \param ch \c chunk to add
+ * \pre \c cs is valid (assert-ed)
+ * \pre \c ch is not \c NULL (assert-ed)
+ */
+extern void chunk_stack_push ( chunk_stack cs ,
+			       chunk ch ) ;
+
+
+/*!
+ * Return the \c chunk on top of the \c chunk_stack.
+ * The \c chunk is removed from the \c chunk_stack.
+ *
+ * \param cs \c chunk_stack to pop from
+ * \pre \c cs is valid (assert-ed)
+ * \return The removed \c chunk or \c NULL if the \c chunk_stack is empty
+ */
+extern chunk chunk_stack_pop ( chunk_stack cs ) ;
+
+
+/*!
+ * Return the \c chunk on top of the \c chunk_stack.
+ * The \c chunk is \b not removed (nor copied).
+ *
+ * \param cs \c chunk_stack to query
+ * \pre \c cs is valid (assert-ed)
+ * \return The \c chunk on top or \c NULL if the \c chunk_stack is empty
+ */
+extern chunk chunk_stack_peek ( chunk_stack cs ) ;
+
+
+/*!
+ * Return the \c chunk at some depth of the \c chunk_stack (0 is the top).
+ * The \c chunk is \b not removed (nor copied).
+ *
+ * \param cs \c chunk_stack to query
+ * \param n depth of the \c chunk
+ * \pre \c cs is valid (assert-ed)
+ * \return The \c chunk at depth \c n or \c NULL if the \c chunk_stack is not deep enough
+ */
+extern chunk chunk_stack_nth ( chunk_stack cs ,
+			       unsigned int n ) ;
+
+
+/*!
+ * Push a \b copy of the \c k \c chunk's on top of the \c chunk_stack.
+ * If there is less than \c k \c chunk then no copy is made.
+ *
+ * For \c k, the following \c chunk_stack
+ * \verbatim [top]                                     ch0 ch_1 ch_2 ...  ch_k-2 ch_k-1   ch_k ch_k+1 ch_k+2 \endverbatim
+ * is transformed into
+ * \verbatim [top]  ch0 ch_1 ch_2 ...  ch_k-2 ch_k-1   ch0 ch_1 ch_2 ...  ch_k-2 ch_k-1   ch_k ch_k+1 ch_k+2 \endverbatim
+ *
+ * \param cs \c chunk_stack to add to
+ * \param k number of \c chunk's to copy
+ * \pre \c cs is valid (assert-ed)
+ * \return false if there where less than k element. In such a case, no copy is made.
+ */
+extern bool chunk_stack_dup_n ( chunk_stack cs ,
+				unsigned int k ) ;
+
+
+# endif
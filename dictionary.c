@@ -1,7 +1,8 @@
-# include <stdlib.h> // malloc + free
+# include <stdlib.h> // malloc + calloc + realloc + free
 # include <assert.h>
 
 # include "dictionary.h"
+# include "linked_list_chunk.h"
 
 # undef NDEBUG   // FORCE ASSERT ACTIVATION
 
@@ -18,9 +19,15 @@
  * Keys and values are copied to get independent long term storage.
  * In the same spirit, queried values are \b copies. 
  * The <b>caller is in charge of destroying copies</b>; this is indicated by the \c _copy in the query function name.
+ * Values can also be \b borrowed (no copy), this is indicated by the \c _borrowed in the query function name.
  *
- * Values are stored in an ordered binary tree.
- * They are two data structures: one for the dictionary and one for nodes.
+ * Entries are nodes of an AVL tree ordered by key (alphabetical order).
+ * Insertion and removal are thus in O(log n) and entries can be walked in order (or from a given key) without sorting.
+ * All walks (print, copy, search) are iterative, using the \c father links, so that the C stack does not depend on the size.
+ *
+ * Keys are interned as \link symbol\endlink's and nodes are also indexed by symbol in an array, which is used for lookups.
+ * A lookup by symbol is thus a single array access; a lookup by \c sstring only adds a look up in the symbol table.
+ * The slot (node) of a symbol can be kept and reused as long as the version stamp of the \c dictionary is unchanged.
  *
  * \note Cela ressemble au TDM 3, même s'il y a des différences.
  *
@@ -33,217 +40,286 @@
  */
 
 
-/*! \c dictionary is a pointer to the hidden structure for dictionary. */
+/*! Initial size of the array indexed by symbols. */
+# define DICTIONARY_INITIAL_CAPACITY 64
+
+/*! Initial size of the array of holds. */
+# define DICTIONARY_INITIAL_HELD_CAPACITY 16
+
+
+/*! Last version stamp given (shared by all \c dictionary's so that a stamp is never reused). */
+static unsigned long long int dictionary_last_version = 0 ;
+
+
+/*!
+ * A node of the AVL tree (an entry of the dictionary).
+ *
+ * \param sy symbol of the key
+ * \param key key of the entry (the name of the symbol, not a copy)
+ * \param val value of the entry
+ * \param left_son sub-tree with smaller keys
+ * \param right_son sub-tree with greater keys
+ * \param father \c NULL for the root
+ * \param height height of the sub-tree rooted here (1 for a leaf)
+ * \param holds number of holds on the current value (see \link dictionary_hold() \endlink)
+ */
+typedef struct node_struct {
+  symbol sy ;
+  sstring key ;
+  chunk val ;
+  struct node_struct * left_son ;
+  struct node_struct * right_son ;
+  struct node_struct * father ;
+  int height ;
+  unsigned int holds ;
+} node ;
+
+
+/*!
+ * \param root root of the AVL tree (\c NULL if empty)
+ * \param slots nodes indexed by symbol (\c NULL if the symbol is not defined)
+ * \param capacity size of \c slots
+ * \param size number of entries
+ * \param version changed each time a node is added or removed
+ * \param held symbols whose values are currently held, in order of holding (see \link dictionary_hold() \endlink), a symbol may be held more than once
+ * \param held_size number of holds
+ * \param held_capacity size of \c held
+ * \param retired held values that have been replaced or removed (destroyed once nothing is held)
+ */
+struct dictionary_struct {
+  node * root ;
+  node * * slots ;
+  size_t capacity ;
+  size_t size ;
+  unsigned long long int version ;
+  symbol * held ;
+  size_t held_size ;
+  size_t held_capacity ;
+  linked_list_chunk retired ;
+} ;
+
+
+
+/*
+ * AVL TREE
+ */
+
 
-typedef struct node_struct node;
+/*! Height of a possibly empty sub-tree. */
+static int node_height ( node const * const nd ) {
+  return ( NULL == nd ) ? 0 : nd -> height ;
+}
 
-struct node_struct {
-  sstring key;
-  chunk val;
-  node* left_son;
-  node* right_son;
-  node* father;
-};
 
-node* node_create(void) {
-  node* nd = (node*) malloc(sizeof(node));
-  nd->key = sstring_create_empty();
-  nd->val = NULL;
-  nd->left_son = NULL;
-  nd->right_son = NULL;
-  nd->father = NULL;
-  return nd;
+/*! Recompute the height of a node from its sons. */
+static void node_update_height ( node * const nd ) {
+  int const hl = node_height ( nd -> left_son ) ;
+  int const hr = node_height ( nd -> right_son ) ;
+  nd -> height = 1 + ( ( hl < hr ) ? hr : hl ) ;
 }
 
-void node_destroy(node** nd) {
-	if((*nd)->left_son != NULL) {
-		(*nd)->left_son->father = NULL;
-		node_destroy(&((*nd)->left_son));
-		(*nd)->left_son = NULL;
-	}
-	if((*nd)->right_son != NULL) {
-		(*nd)->right_son->father = NULL;
-		node_destroy(&((*nd)->right_son));
-		(*nd)->right_son = NULL;
-	}
-	if((*nd)->father != NULL) {
-		if((*nd)->father->left_son == (*nd)) {
-			(*nd)->father->left_son = NULL;
-		} else {
-			(*nd)->father->right_son = NULL;
-		}
-		node_destroy(&((*nd)->father));
-		(*nd)->father = NULL;
-	}
-	sstring_destroy((*nd)->key);
-	chunk_destroy((*nd)->val);
-	(*nd)->father = NULL;
-	(*nd)->right_son = NULL;
-	(*nd)->left_son = NULL;
-	free(*nd);
+
+/*! Make \c new_son take the place of \c old_son under \c father (or as the root). */
+static void dictionary_replace_son ( dictionary dic ,
+				     node * const father ,
+				     node * const old_son ,
+				     node * const new_son ) {
+  if ( NULL == father ) {
+    dic -> root = new_son ;
+  } else if ( father -> left_son == old_son ) {
+    father -> left_son = new_son ;
+  } else {
+    father -> right_son = new_son ;
+  }
+  if ( NULL != new_son ) {
+    new_son -> father = father ;
+  }
 }
 
-void node_print(node* nd, FILE* f) {
-	if(nd->left_son != NULL)
-		node_print(nd->left_son, f);
-	if(nd->right_son != NULL)
-		node_print(nd->right_son, f);
-	chunk_print(nd->val, f);
-	fprintf(f, "\n");
+
+/*! Left rotation around \c nd, return the new root of the sub-tree. */
+static node * dictionary_rotate_left ( dictionary dic ,
+				       node * const nd ) {
+  node * const rs = nd -> right_son ;
+  dictionary_replace_son ( dic , nd -> father , nd , rs ) ;
+  nd -> right_son = rs -> left_son ;
+  if ( NULL != nd -> right_son ) {
+    nd -> right_son -> father = nd ;
+  }
+  rs -> left_son = nd ;
+  nd -> father = rs ;
+  node_update_height ( nd ) ;
+  node_update_height ( rs ) ;
+  return rs ;
 }
 
-bool node_is_leaf(node* nd) {
-	return (nd->right_son == NULL) && (nd->left_son == NULL);
+
+/*! Right rotation around \c nd, return the new root of the sub-tree. */
+static node * dictionary_rotate_right ( dictionary dic ,
+					node * const nd ) {
+  node * const ls = nd -> left_son ;
+  dictionary_replace_son ( dic , nd -> father , nd , ls ) ;
+  nd -> left_son = ls -> right_son ;
+  if ( NULL != nd -> left_son ) {
+    nd -> left_son -> father = nd ;
+  }
+  ls -> right_son = nd ;
+  nd -> father = ls ;
+  node_update_height ( nd ) ;
+  node_update_height ( ls ) ;
+  return ls ;
 }
 
-int node_size(node* nd) {
-	int size = 0;
-	if(nd->left_son != NULL)
-		size += node_size(nd->left_son);
-	if(nd->right_son != NULL)
-		size += node_size(nd->right_son);
-	return size + 1;
+
+/*!
+ * Restore heights and balance from a node up to the root (after an insertion or a removal under it).
+ */
+static void dictionary_rebalance ( dictionary dic ,
+				   node * nd ) {
+  while ( NULL != nd ) {
+    node_update_height ( nd ) ;
+    int const balance = node_height ( nd -> left_son ) - node_height ( nd -> right_son ) ;
+    if ( 1 < balance ) {
+      if ( node_height ( nd -> left_son -> left_son ) < node_height ( nd -> left_son -> right_son ) ) {
+	dictionary_rotate_left ( dic , nd -> left_son ) ;
+      }
+      nd = dictionary_rotate_right ( dic , nd ) ;
+    } else if ( balance < -1 ) {
+      if ( node_height ( nd -> right_son -> right_son ) < node_height ( nd -> right_son -> left_son ) ) {
+	dictionary_rotate_right ( dic , nd -> right_son ) ;
+      }
+      nd = dictionary_rotate_left ( dic , nd ) ;
+    }
+    nd = nd -> father ;
+  }
 }
 
-chunk node_search(node* nd, sstring key) {
-	int cmp = sstring_compare(key, nd->key);
-	if(cmp == 0) {
-		return nd->val;
-	} else {
-		if(1 <= cmp) {
-			if(nd->right_son != NULL)
-				return node_search(nd->right_son, key);
-		} else {
-			if(nd->left_son != NULL)
-				return node_search(nd->left_son, key);
-		}
-		return NULL;
-	}
+
+/*! Left-most node of a sub-tree. */
+static node * node_first ( node * nd ) {
+  while ( NULL != nd -> left_son ) {
+    nd = nd -> left_son ;
+  }
+  return nd ;
 }
 
-void node_add_value(node* nd, sstring key, chunk value) {
-	assert(!sstring_is_empty(key));
-	if(sstring_is_empty(nd->key)) {
-		int cmp = sstring_compare(nd->key, key);
-		if(cmp != 0) {
-			if (cmp <= -1) {
-				if(nd->right_son == NULL) {
-					nd->right_son = node_create();
-					sstring_concatenate(nd->right_son->key, key);
-					nd->right_son->val = chunk_copy(value);
-				} else
-					node_add_value(nd->right_son, key, value);
-			} else {
-				if(nd->left_son == NULL) {
-					nd->left_son = node_create();
-					sstring_concatenate(nd->left_son->key, key);
-					nd->left_son->val = chunk_copy(value);
-				} else
-					node_add_value(nd->left_son, key, value);
-			}
-		}
-	} else {
-		sstring_concatenate(nd->key, key);
-		nd->val = chunk_copy(value);
-	}	
+
+/*! Next node in alphabetical order (\c NULL if none). */
+static node * node_next ( node * nd ) {
+  if ( NULL != nd -> right_son ) {
+    return node_first ( nd -> right_son ) ;
+  }
+  while ( ( NULL != nd -> father ) && ( nd -> father -> right_son == nd ) ) {
+    nd = nd -> father ;
+  }
+  return nd -> father ;
 }
 
-void node_del_value(node* nd, sstring key) {
-	int cmp = sstring_compare(key, nd->key);
-	if(1 <= cmp) {
-		if(nd->right_son != NULL)
-			node_del_value(nd->right_son, key);
-	} else if (cmp <= -1) {
-		if(nd->left_son != NULL)
-			node_del_value(nd->left_son, key);
-	} else {
-		if(nd->right_son == NULL && nd->left_son == NULL) {
-			if(nd->father != NULL) {
-				if(nd->father->right_son == nd) {
-					nd->father->right_son = NULL;
-				} else {
-					nd->father->left_son = NULL;
-				}
-			}
-			sstring_destroy(nd->key);
-			chunk_destroy(nd->val);
-			nd->father = NULL;
-			nd->right_son = NULL;
-			nd->left_son = NULL;
-			free(nd);
-		} else {
-			if(nd->right_son != NULL && nd->left_son != NULL) {
-				node* inter = nd->right_son;
-				while(inter->left_son != NULL) {
-					inter = inter->left_son;
-				}
-				inter->father = nd->father;
-				if(nd->father != NULL) {
-					if(nd->father->right_son == nd) {
-						nd->father->right_son = inter;
-					} else {
-						nd->father->left_son = inter;
-					}
-				}
-				inter->left_son = nd->left_son;
-				nd->left_son->father = inter;
-				if(nd->right_son != inter) {
-					nd->right_son->father = inter;
-					inter->right_son = nd->right_son;
-				}
-				sstring_destroy(nd->key);
-				chunk_destroy(nd->val);
-				nd->father = NULL;
-				nd->right_son = NULL;
-				nd->left_son = NULL;
-				free(nd);
-			} else {
-				node* inter;
-				if(nd->left_son != NULL) {
-					inter = nd->left_son;
-				} else {
-					inter = nd->right_son;
-				}
-				inter->father = nd->father;
-				if(nd->father != NULL) {
-					if(nd->father->left_son == nd) {
-						nd->father->left_son = inter;
-					} else {
-						nd->father->right_son = inter;
-					}
-				}
-				sstring_destroy(nd->key);
-				chunk_destroy(nd->val);
-				nd->father = NULL;
-				nd->right_son = NULL;
-				nd->left_son = NULL;
-				free(nd);
-			}
-		}
-	}
+
+/*! First node whose key is not less than \c key (\c NULL if none). */
+static node * dictionary_lower_bound ( dictionary dic ,
+				       sstring const key ) {
+  node * nd = dic -> root ;
+  node * bound = NULL ;
+  while ( NULL != nd ) {
+    if ( sstring_compare ( nd -> key , key ) < 0 ) {
+      nd = nd -> right_son ;
+    } else {
+      bound = nd ;
+      nd = nd -> left_son ;
+    }
+  }
+  return bound ;
 }
 
-node* node_copy(node* nd) {
-	node* res = (node*) malloc(sizeof(node));
-	res->key = sstring_copy(nd->key);
-	res->val = chunk_copy(nd->val);
-	res->father = NULL;
-	if(nd->right_son != NULL) {
-		res->right_son = node_copy(nd->right_son);
-		res->right_son->father = res;
-	} else
-		res->right_son = NULL;
-	if(nd->left_son != NULL) {
-		res->left_son = node_copy(nd->left_son);
-		res->left_son->father = res;
-	} else
-		res->left_son = NULL;
-	return res;
+
+/*! Allocate a node with no son. */
+static node * node_create ( symbol const sy ,
+			    chunk const val ,
+			    node * const father ) {
+  node * const nd = ( node * ) malloc ( sizeof ( node ) ) ;
+  assert ( NULL != nd ) ;
+  nd -> sy = sy ;
+  nd -> key = symbol_get_name ( sy ) ;
+  nd -> val = val ;
+  nd -> left_son = NULL ;
+  nd -> right_son = NULL ;
+  nd -> father = father ;
+  nd -> height = 1 ;
+  nd -> holds = 0 ;
+  return nd ;
+}
+
+
+
+/*
+ * INDEX BY SYMBOL
+ */
+
+
+/*!
+ * Ensure that the index can hold a symbol.
+ */
+static void dictionary_reserve ( dictionary dic ,
+				 symbol const sy ) {
+  if ( sy < dic -> capacity ) {
+    return ;
+  }
+  size_t capacity = dic -> capacity ;
+  while ( capacity <= sy ) {
+    capacity *= 2 ;
+  }
+  dic -> slots = ( node * * ) realloc ( dic -> slots , capacity * sizeof ( node * ) ) ;
+  assert ( NULL != dic -> slots ) ;
+  for ( size_t i = dic -> capacity ; i < capacity ; i ++ ) {
+    dic -> slots [ i ] = NULL ;
+  }
+  dic -> capacity = capacity ;
+}
+
+
+/*!
+ * Node of a symbol (\c NULL if undefined).
+ */
+static node * dictionary_find ( dictionary dic ,
+				symbol const sy ) {
+  return ( sy < dic -> capacity )
+    ? dic -> slots [ sy ]
+    : NULL ;
+}
+
+
+
+/*
+ * DICTIONARY
+ */
+
+
+/*!
+ * Get rid of the value of a node that is no longer stored: it is destroyed unless it is held.
+ * The hold count of the node is reset since it only counts the holds on the current value.
+ */
+static void dictionary_discard_value ( dictionary dic ,
+				       node * const nd ) {
+  if ( 0 < nd -> holds ) {
+    linked_list_chunk_add_front ( dic -> retired , nd -> val ) ;
+    nd -> holds = 0 ;
+  } else {
+    chunk_destroy ( nd -> val ) ;
+  }
+}
+
+
+/*!
+ * Generate an empty array of holds.
+ */
+static void dictionary_held_create ( dictionary dic ) {
+  dic -> held = ( symbol * ) malloc ( DICTIONARY_INITIAL_HELD_CAPACITY * sizeof ( symbol ) ) ;
+  assert ( NULL != dic -> held ) ;
+  dic -> held_size = 0 ;
+  dic -> held_capacity = DICTIONARY_INITIAL_HELD_CAPACITY ;
 }
 
-struct dictionary_struct {
-  node* tree;
-};
 
 /*!
  * Generate an empty \c dictionary.
@@ -251,9 +327,17 @@ struct dictionary_struct {
  * \return an empty \c dictionary
  */
 dictionary dictionary_create ( void )  {
-  dictionary dic = (dictionary) malloc(sizeof(struct dictionary_struct));
-  dic->tree = node_create();
-  return dic;
+  dictionary dic = ( dictionary ) malloc ( sizeof ( struct dictionary_struct ) ) ;
+  assert ( NULL != dic ) ;
+  dic -> root = NULL ;
+  dic -> slots = ( node * * ) calloc ( DICTIONARY_INITIAL_CAPACITY , sizeof ( node * ) ) ;
+  assert ( NULL != dic -> slots ) ;
+  dic -> capacity = DICTIONARY_INITIAL_CAPACITY ;
+  dic -> size = 0 ;
+  dic -> version = ++ dictionary_last_version ;
+  dictionary_held_create ( dic ) ;
+  dic -> retired = linked_list_chunk_create () ;
+  return dic ;
 }
 
 
@@ -269,10 +353,56 @@ dictionary dictionary_create ( void )  {
  * \pre no pointer is NULL (assert-ed)
  * \pre key is not an empty string  (assert-ed)
  */
-void dictionary_set ( dictionary dic , sstring key , chunk val )  {
-  assert(key != NULL && val != NULL);
-  assert(!sstring_is_empty(key));
-  node_add_value(dic->tree, key, val);
+void dictionary_set ( dictionary dic ,
+		      sstring key ,
+		      chunk val )  {
+  assert ( NULL != dic ) ;
+  assert ( NULL != key ) ;
+  assert ( NULL != val ) ;
+  assert ( ! sstring_is_empty ( key ) ) ;
+  dictionary_set_symbol ( dic , symbol_intern ( key ) , val ) ;
+}
+
+
+/*!
+ * Add an entry \c (key,val) into a \c dictionary, the key being given by its symbol.
+ *
+ * A copy of val is made.
+ * The original value can be safely destroyed after the call.
+ *
+ * \param dic \c dictionary to modify
+ * \param sy insertion key
+ * \param val inserted value
+ * \pre no pointer is NULL (assert-ed)
+ * \pre sy is an interned symbol
+ */
+void dictionary_set_symbol ( dictionary dic ,
+			     symbol sy ,
+			     chunk val ) {
+  assert ( NULL != dic ) ;
+  assert ( NULL != val ) ;
+  node * const nd = dictionary_find ( dic , sy ) ;
+  if ( NULL != nd ) {
+    dictionary_discard_value ( dic , nd ) ;
+    nd -> val = chunk_copy ( val ) ;
+    return ;
+  }
+  dictionary_reserve ( dic , sy ) ;
+  // Insertion in the tree
+  sstring const key = symbol_get_name ( sy ) ;
+  node * father = NULL ;
+  node * * son = & ( dic -> root ) ;
+  while ( NULL != * son ) {
+    father = * son ;
+    son = ( sstring_compare ( key , father -> key ) < 0 )
+      ? & ( father -> left_son )
+      : & ( father -> right_son ) ;
+  }
+  * son = node_create ( sy , chunk_copy ( val ) , father ) ;
+  dic -> slots [ sy ] = * son ;
+  dic -> size ++ ;
+  dic -> version = ++ dictionary_last_version ;
+  dictionary_rebalance ( dic , father ) ;
 }
 
 
@@ -285,8 +415,229 @@ void dictionary_set ( dictionary dic , sstring key , chunk val )  {
  * \pre key is not empty
  * \return a \b copy of the associated \c chunk or NULL if undefined 
  */
-chunk dictionary_get_copy ( dictionary dic , sstring key )  {
-	return chunk_copy(node_search(dic->tree, key));
+chunk dictionary_get_copy ( dictionary dic ,
+			    sstring key )  {
+  assert ( NULL != dic ) ;
+  assert ( NULL != key ) ;
+  node const * const nd = dictionary_find ( dic , symbol_find ( key ) ) ;
+  return ( NULL == nd )
+    ? NULL
+    : chunk_copy ( nd -> val ) ;
+}
+
+
+/*!
+ * Retrieve a \b borrowed value from a \c dictionary according to a \c key.
+ *
+ * The value still belongs to the \c dictionary: it must neither be modified nor destroyed.
+ * It is only valid until the next modification of the \c dictionary (\c set or \c remove) unless it is held (see \link dictionary_hold() \endlink).
+ *
+ * \param dic \c dictionary to query from
+ * \param key key to search a value for
+ * \pre no pointer is NULL (assert-ed)
+ * \return the associated \c chunk (\b not a copy) or NULL if undefined 
+ */
+chunk dictionary_get_borrowed ( dictionary dic ,
+				sstring key ) {
+  assert ( NULL != dic ) ;
+  assert ( NULL != key ) ;
+  node const * const nd = dictionary_find ( dic , symbol_find ( key ) ) ;
+  return ( NULL == nd )
+    ? NULL
+    : nd -> val ;
+}
+
+
+/*!
+ * Retrieve the slot of a symbol in a \c dictionary.
+ * The slot remains valid as long as \link dictionary_get_version() \endlink returns the same stamp.
+ *
+ * \param dic \c dictionary to query from
+ * \param sy symbol to search a slot for
+ * \pre no pointer is NULL (assert-ed)
+ * \return the slot of \c sy or NULL if undefined 
+ */
+dictionary_slot dictionary_get_slot ( dictionary dic ,
+				      symbol sy ) {
+  assert ( NULL != dic ) ;
+  return dictionary_find ( dic , sy ) ;
+}
+
+
+/*!
+ * Retrieve a \b borrowed value from a slot (same validity as \link dictionary_get_borrowed() \endlink).
+ *
+ * \param slot slot to query from
+ * \pre no pointer is NULL (assert-ed)
+ * \return the \c chunk of the slot (\b not a copy)
+ */
+chunk dictionary_slot_get_borrowed ( dictionary_slot slot ) {
+  assert ( NULL != slot ) ;
+  return slot -> val ;
+}
+
+
+/*!
+ * Version stamp of a \c dictionary.
+ * It changes each time an entry is added or removed (but not when an entry is redefined).
+ * Stamps are never reused, even by another \c dictionary.
+ *
+ * \param dic \c dictionary to query
+ * \pre no pointer is NULL (assert-ed)
+ * \return the current stamp
+ */
+unsigned long long int dictionary_get_version ( dictionary dic ) {
+  assert ( NULL != dic ) ;
+  return dic -> version ;
+}
+
+
+/*!
+ * Hold the value of a symbol: until the matching \link dictionary_release() \endlink, it is not destroyed even if it is replaced or removed from the \c dictionary.
+ * So that a borrowed value remains valid while the \c dictionary is modified (f.e. a \c value_block that redefines its own label while executed).
+ * Holds can be nested, they must be released in reverse order.
+ *
+ * The node counts the holds on its current value, so that replacing or removing a value does not look for it among the holds.
+ *
+ * \param dic \c dictionary the value was borrowed from
+ * \param sy symbol whose value is held
+ * \pre no pointer is NULL (assert-ed)
+ * \pre \c sy is defined in \c dic (assert-ed)
+ */
+void dictionary_hold ( dictionary dic ,
+		       symbol sy ) {
+  assert ( NULL != dic ) ;
+  node * const nd = dictionary_find ( dic , sy ) ;
+  assert ( NULL != nd ) ;
+  if ( dic -> held_size == dic -> held_capacity ) {
+    dic -> held_capacity *= 2 ;
+    dic -> held = ( symbol * ) realloc ( dic -> held , dic -> held_capacity * sizeof ( symbol ) ) ;
+    assert ( NULL != dic -> held ) ;
+  }
+  dic -> held [ dic -> held_size ++ ] = sy ;
+  nd -> holds ++ ;
+}
+
+
+/*!
+ * Release the last hold on a \c dictionary.
+ * Once nothing is held anymore, the held values that were replaced or removed meanwhile are destroyed.
+ *
+ * If the held value was replaced or removed meanwhile, the count of its symbol (if any) only counts later holds, which are already released, so that it is 0 and left unchanged.
+ *
+ * \param dic \c dictionary to release
+ * \pre no pointer is NULL (assert-ed)
+ * \pre something is held (assert-ed)
+ */
+void dictionary_release ( dictionary dic ) {
+  assert ( NULL != dic ) ;
+  assert ( 0 < dic -> held_size ) ;
+  node * const nd = dictionary_find ( dic , dic -> held [ -- dic -> held_size ] ) ;
+  if ( ( NULL != nd ) && ( 0 < nd -> holds ) ) {
+    nd -> holds -- ;
+  }
+  if ( 0 == dic -> held_size ) {
+    chunk ch ;
+    while ( NULL != ( ch = linked_list_chunk_pop_front ( dic -> retired ) ) ) {
+      chunk_destroy ( ch ) ;
+    }
+  }
+}
+
+
+/*!
+ * Remove an entry from a \c dictionary.
+ * The key and value stored are destroyed.
+ *
+ * \param dic \c dictionary to modify
+ * \param key key of the entry to remove
+ * \pre no pointer is NULL (assert-ed)
+ * \return false if there were no such entry
+ */
+bool dictionary_remove ( dictionary dic ,
+			 sstring key ) {
+  assert ( NULL != dic ) ;
+  assert ( NULL != key ) ;
+  node * nd = dictionary_find ( dic , symbol_find ( key ) ) ;
+  if ( NULL == nd ) {
+    return false ;
+  }
+  dic -> slots [ nd -> sy ] = NULL ;
+  dictionary_discard_value ( dic , nd ) ;
+  if ( ( NULL != nd -> left_son ) && ( NULL != nd -> right_son ) ) {
+    // The entry of the next node is moved here and the next node is removed instead
+    node * const next = node_first ( nd -> right_son ) ;
+    dic -> slots [ next -> sy ] = nd ;
+    nd -> sy = next -> sy ;
+    nd -> key = next -> key ;
+    nd -> val = next -> val ;
+    nd -> holds = next -> holds ;
+    nd = next ;
+  }
+  // nd has at most one son
+  node * const father = nd -> father ;
+  dictionary_replace_son ( dic , father , nd ,
+			   ( NULL != nd -> left_son ) ? nd -> left_son : nd -> right_son ) ;
+  free ( nd ) ;
+  dic -> size -- ;
+  dic -> version = ++ dictionary_last_version ;
+  dictionary_rebalance ( dic , father ) ;
+  return true ;
+}
+
+
+/*!
+ * Copy a node (without its sons) into \c dic, under \c father.
+ */
+static node * dictionary_copy_node ( dictionary dic ,
+				     node const * const src ,
+				     node * const father ) {
+  node * const nd = node_create ( src -> sy , chunk_copy ( src -> val ) , father ) ;
+  nd -> height = src -> height ;
+  dic -> slots [ nd -> sy ] = nd ;
+  return nd ;
+}
+
+
+/*!
+ * Provide a copy of a \c dictionary.
+ * Keys are copied and values are copied with \c chunk_copy.
+ *
+ * \param dic \c dictionary to copy
+ * \pre no pointer is NULL (assert-ed)
+ * \return an independent copy of \c dic
+ */
+dictionary dictionary_copy ( dictionary dic ) {
+  assert ( NULL != dic ) ;
+  dictionary copy = ( dictionary ) malloc ( sizeof ( struct dictionary_struct ) ) ;
+  assert ( NULL != copy ) ;
+  copy -> slots = ( node * * ) calloc ( dic -> capacity , sizeof ( node * ) ) ;
+  assert ( NULL != copy -> slots ) ;
+  copy -> capacity = dic -> capacity ;
+  copy -> size = dic -> size ;
+  copy -> version = ++ dictionary_last_version ;
+  copy -> root = NULL ;
+  dictionary_held_create ( copy ) ;
+  copy -> retired = linked_list_chunk_create () ;
+  if ( NULL == dic -> root ) {
+    return copy ;
+  }
+  // Both trees are walked together, a son is copied when it is first reached
+  node const * src = dic -> root ;
+  node * dst = copy -> root = dictionary_copy_node ( copy , src , NULL ) ;
+  while ( NULL != src ) {
+    if ( ( NULL != src -> left_son ) && ( NULL == dst -> left_son ) ) {
+      src = src -> left_son ;
+      dst = dst -> left_son = dictionary_copy_node ( copy , src , dst ) ;
+    } else if ( ( NULL != src -> right_son ) && ( NULL == dst -> right_son ) ) {
+      src = src -> right_son ;
+      dst = dst -> right_son = dictionary_copy_node ( copy , src , dst ) ;
+    } else {
+      src = src -> father ;
+      dst = dst -> father ;
+    }
+  }
+  return copy ;
 }
 
 
@@ -298,8 +649,31 @@ chunk dictionary_get_copy ( dictionary dic , sstring key )  {
  * \pre no pointer is NULL (assert-ed)
  */
 void dictionary_destroy ( dictionary dic )  {
-	node_destroy(&(dic->tree));
-	free(dic);
+  assert ( NULL != dic ) ;
+  assert ( 0 == dic -> held_size ) ;
+  // Every node is in the index, so that no tree walk is needed
+  for ( size_t i = 0 ; i < dic -> capacity ; i ++ ) {
+    node * const nd = dic -> slots [ i ] ;
+    if ( NULL != nd ) {
+      chunk_destroy ( nd -> val ) ;
+      free ( nd ) ;
+    }
+  }
+  free ( dic -> slots ) ;
+  free ( dic -> held ) ;
+  linked_list_chunk_destroy ( dic -> retired ) ;
+  free ( dic ) ;
+}
+
+
+/*! Print one entry. */
+static void node_print ( node const * const nd ,
+			 FILE * f ) {
+  fputc ( '"' , f ) ;
+  sstring_print ( nd -> key , f ) ;
+  fputs ( "\" => " , f ) ;
+  chunk_print ( nd -> val , f ) ;
+  fputc ( '\n' , f ) ;
 }
 
 
@@ -320,6 +694,40 @@ void dictionary_destroy ( dictionary dic )  {
  * \param f stream to print to
  * \pre no pointer is NULL (assert-ed)
  */
-void dictionary_print ( dictionary dic , FILE * f )  {
-	node_print(dic->tree, f);
-}
\ No newline at end of file
+void dictionary_print ( dictionary dic ,
+			FILE * f )  {
+  assert ( NULL != dic ) ;
+  assert ( NULL != f ) ;
+  if ( NULL == dic -> root ) {
+    return ;
+  }
+  for ( node * nd = node_first ( dic -> root ) ; NULL != nd ; nd = node_next ( nd ) ) {
+    node_print ( nd , f ) ;
+  }
+}
+
+
+/*!
+ * Print the entries of a \c dictionary whose keys are in a range (bounds included), in the same format as \link dictionary_print() \endlink.
+ * This costs O(log n) plus the number of printed entries.
+ *
+ * \param dic \c dictionary to print
+ * \param first lower bound of the keys
+ * \param last upper bound of the keys
+ * \param f stream to print to
+ * \pre no pointer is NULL (assert-ed)
+ */
+void dictionary_print_range ( dictionary dic ,
+			      sstring first ,
+			      sstring last ,
+			      FILE * f ) {
+  assert ( NULL != dic ) ;
+  assert ( NULL != first ) ;
+  assert ( NULL != last ) ;
+  assert ( NULL != f ) ;
+  for ( node * nd = dictionary_lower_bound ( dic , first ) ;
+	( NULL != nd ) && ( sstring_compare ( nd -> key , last ) <= 0 ) ;
+	nd = node_next ( nd ) ) {
+    node_print ( nd , f ) ;
+  }
+}
@@ -7,6 +7,7 @@
 
 
 # include "sstring.h"
+# include "symbol.h"
 # include "chunk.h"
 
 /*!
@@ -18,9 +19,15 @@
  * Keys and values are copied to get independent long term storage.
  * In the same spirit, queried values are \b copies. 
  * The <b>caller is in charge of destroying copies</b>; this is indicated by the \c _copy in the query function name.
+ * Values can also be \b borrowed (no copy), this is indicated by the \c _borrowed in the query function name.
  *
- * Values are stored in an ordered binary tree.
- * They are two data structures: one for the dictionary and one for nodes.
+ * Entries are nodes of an AVL tree ordered by key (alphabetical order).
+ * Insertion and removal are thus in O(log n) and entries can be walked in order (or from a given key) without sorting.
+ * All walks (print, copy, search) are iterative, using the \c father links, so that the C stack does not depend on the size.
+ *
+ * Keys are interned as \link symbol\endlink's and nodes are also indexed by symbol in an array, which is used for lookups.
+ * A lookup by symbol is thus a single array access; a lookup by \c sstring only adds a look up in the symbol table.
+ * The slot (node) of a symbol can be kept and reused as long as the version stamp of the \c dictionary is unchanged.
  *
  * \note Cela ressemble au TDM 3, même s'il y a des différences.
  *
@@ -37,6 +44,10 @@
 typedef struct dictionary_struct * dictionary ;  
 
 
+/*! \c dictionary_slot is a pointer to the hidden structure of an entry. */
+typedef struct node_struct const * dictionary_slot ;
+
+
 /*!
  * Generate an empty \c dictionary.
  *
@@ -62,6 +73,23 @@ extern void dictionary_set ( dictionary dic ,
 			     chunk val ) ;
 
 
+/*!
+ * Add an entry \c (key,val) into a \c dictionary, the key being given by its symbol.
+ *
+ * A copy of val is made.
+ * The original value can be safely destroyed after the call.
+ *
+ * \param dic \c dictionary to modify
+ * \param sy insertion key
+ * \param val inserted value
+ * \pre no pointer is NULL (assert-ed)
+ * \pre sy is an interned symbol
+ */
+extern void dictionary_set_symbol ( dictionary dic ,
+				    symbol sy ,
+				    chunk val ) ;
+
+
 /*!
  * Retrieve a \b copied value from a \c dictionary according to a \c key.
  *
@@ -75,6 +103,107 @@ extern chunk dictionary_get_copy ( dictionary dic ,
 				   sstring key ) ;
 
 
+/*!
+ * Retrieve a \b borrowed value from a \c dictionary according to a \c key.
+ *
+ * The value still belongs to the \c dictionary: it must neither be modified nor destroyed.
+ * It is only valid until the next modification of the \c dictionary (\c set or \c remove) unless it is held (see \link dictionary_hold() \endlink).
+ *
+ * \param dic \c dictionary to query from
+ * \param key key to search a value for
+ * \pre no pointer is NULL (assert-ed)
+ * \return the associated \c chunk (\b not a copy) or NULL if undefined 
+ */
+extern chunk dictionary_get_borrowed ( dictionary dic ,
+				       sstring key ) ;
+
+
+/*!
+ * Retrieve the slot of a symbol in a \c dictionary.
+ * The slot remains valid as long as \link dictionary_get_version() \endlink returns the same stamp.
+ *
+ * \param dic \c dictionary to query from
+ * \param sy symbol to search a slot for
+ * \pre no pointer is NULL (assert-ed)
+ * \return the slot of \c sy or NULL if undefined 
+ */
+extern dictionary_slot dictionary_get_slot ( dictionary dic ,
+					     symbol sy ) ;
+
+
+/*!
+ * Retrieve a \b borrowed value from a slot (same validity as \link dictionary_get_borrowed() \endlink).
+ *
+ * \param slot slot to query from
+ * \pre no pointer is NULL (assert-ed)
+ * \return the \c chunk of the slot (\b not a copy)
+ */
+extern chunk dictionary_slot_get_borrowed ( dictionary_slot slot ) ;
+
+
+/*!
+ * Version stamp of a \c dictionary.
+ * It changes each time an entry is added or removed (but not when an entry is redefined).
+ * Stamps are never reused, even by another \c dictionary.
+ *
+ * \param dic \c dictionary to query
+ * \pre no pointer is NULL (assert-ed)
+ * \return the current stamp
+ */
+extern unsigned long long int dictionary_get_version ( dictionary dic ) ;
+
+
+/*!
+ * Hold the value of a symbol: until the matching \link dictionary_release() \endlink, it is not destroyed even if it is replaced or removed from the \c dictionary.
+ * So that a borrowed value remains valid while the \c dictionary is modified (f.e. a \c value_block that redefines its own label while executed).
+ * Holds can be nested, they must be released in reverse order.
+ *
+ * The node counts the holds on its current value, so that replacing or removing a value does not look for it among the holds.
+ *
+ * \param dic \c dictionary the value was borrowed from
+ * \param sy symbol whose value is held
+ * \pre no pointer is NULL (assert-ed)
+ * \pre \c sy is defined in \c dic (assert-ed)
+ */
+extern void dictionary_hold ( dictionary dic ,
+			      symbol sy ) ;
+
+
+/*!
+ * Release the last hold on a \c dictionary.
+ * Once nothing is held anymore, the held values that were replaced or removed meanwhile are destroyed.
+ *
+ * \param dic \c dictionary to release
+ * \pre no pointer is NULL (assert-ed)
+ * \pre something is held (assert-ed)
+ */
+extern void dictionary_release ( dictionary dic ) ;
+
+
+/*!
+ * Remove an entry from a \c dictionary.
+ * The key and value stored are destroyed.
+ *
+ * \param dic \c dictionary to modify
+ * \param key key of the entry to remove
+ * \pre no pointer is NULL (assert-ed)
+ * \return false if there were no such entry
+ */
+extern bool dictionary_remove ( dictionary dic ,
+				sstring key ) ;
+
+
+/*!
+ * Provide a copy of a \c dictionary.
+ * Keys are copied and values are copied with \c chunk_copy.
+ *
+ * \param dic \c dictionary to copy
+ * \pre no pointer is NULL (assert-ed)
+ * \return an independent copy of \c dic
+ */
+extern dictionary dictionary_copy ( dictionary dic ) ;
+
+
 /*!
  * Destroy a \c dictionary and released associated resources.
  * All keys and values are destroyed.
@@ -106,7 +235,20 @@ extern void dictionary_print ( dictionary dic ,
 			       FILE * f ) ;
 
 
-
+/*!
+ * Print the entries of a \c dictionary whose keys are in a range (bounds included), in the same format as \link dictionary_print() \endlink.
+ * This costs O(log n) plus the number of printed entries.
+ *
+ * \param dic \c dictionary to print
+ * \param first lower bound of the keys
+ * \param last upper bound of the keys
+ * \param f stream to print to
+ * \pre no pointer is NULL (assert-ed)
+ */
+extern void dictionary_print_range ( dictionary dic ,
+				     sstring first ,
+				     sstring last ,
+				     FILE * f ) ;
 
 
 # endif
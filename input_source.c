@@ -0,0 +1,250 @@
+# define _POSIX_C_SOURCE 200809L   // fileno + fstat + mmap + ftello
+
+# include <stdlib.h>
+# include <stdbool.h>
+# include <stdint.h>
+# include <string.h>
+# include <assert.h>
+
+# ifndef INPUT_SOURCE_NO_MMAP
+# include <sys/types.h>
+# include <sys/stat.h>
+# include <sys/mman.h>
+# endif
+
+# include "input_source.h"
+
+
+# undef NDEBUG   // FORCE ASSERT ACTIVATION
+
+
+
+/*!
+ * \file
+ * \brief Source of the program text read by \link read_chunk_io() \endlink.
+ *
+ * If the stream is a regular file, the whole file is mapped in memory (\c mmap) and read directly from the mapping.
+ * Otherwise (pipe, terminal…), it is read by large blocks (\link INPUT_SOURCE_BLOCK_SIZE \endlink) into a buffer.
+ * In both cases, reading a \c char is an access to memory (there is no call to \c getc).
+ *
+ * A position can be marked (typically the beginning of a token) so that the \c char's read since then can be accessed in place with \link input_source_get_marked() \endlink.
+ * Tokens are thus sliced directly out of the mapping (or buffer) without being copied \c char by \c char.
+ *
+ * If \c INPUT_SOURCE_NO_MMAP is defined at compilation, regular files are also read by blocks.
+ *
+ * The stream is not closed by \c input_source.
+ *
+ * assert is enforced.
+ *
+ * \author Jérôme DURAND-LOSE
+ * \version 1
+ * \date 2015
+ * \copyright GNU Public License.
+ */
+
+
+/*!
+ * \param f stream read from (only used when not mapped)
+ * \param chars the \c char's available (mapping or buffer)
+ * \param size number of \c char's available
+ * \param position index of the next \c char to read
+ * \param mark index of the marked position (meaningful only if \c is_marked)
+ * \param is_marked whether a position is marked
+ * \param mapping start of the mapping, \c NULL if not mapped
+ * \param mapping_size size of the mapping
+ * \param capacity size of the buffer (when not mapped)
+ * \param is_exhausted whether the end of the stream is reached (when not mapped)
+ */
+struct input_source_struct {
+  FILE * f ;
+  char * chars ;
+  size_t size ;
+  size_t position ;
+  size_t mark ;
+  bool is_marked ;
+  void * mapping ;
+  size_t mapping_size ;
+  size_t capacity ;
+  bool is_exhausted ;
+} ;
+
+
+/*!
+ * Try to map the rest of the stream (from its current position) if it is a non empty regular file.
+ *
+ * \return true iff the stream is mapped
+ */
+static bool input_source_map ( input_source const is ) {
+# ifdef INPUT_SOURCE_NO_MMAP
+  return false ;
+# else
+  int const fd = fileno ( is -> f ) ;
+  struct stat st ;
+  if ( ( fd < 0 ) || ( 0 != fstat ( fd , & st ) ) || ! S_ISREG ( st . st_mode ) || ( 0 == st . st_size ) ) {
+    return false ;
+  }
+  off_t const offset = ftello ( is -> f ) ;
+  if ( ( offset < 0 ) || ( st . st_size <= offset ) ) {
+    return false ;
+  }
+  void * const mapping = mmap ( NULL , st . st_size , PROT_READ , MAP_PRIVATE , fd , 0 ) ;
+  if ( MAP_FAILED == mapping ) {
+    return false ;
+  }
+  is -> mapping = mapping ;
+  is -> mapping_size = st . st_size ;
+  is -> chars = ( char * ) mapping + offset ;
+  is -> size = st . st_size - offset ;
+  is -> is_exhausted = true ;
+  return true ;
+# endif
+}
+
+
+/*!
+ * Make more \c char's available if possible (only when not mapped).
+ * The \c char's from the mark (or the current position if there is no mark) are kept at the beginning of the buffer.
+ *
+ * \return true iff there is some \c char available at the current position
+ */
+static bool input_source_refill ( input_source const is ) {
+  if ( is -> position < is -> size ) {
+    return true ;
+  }
+  if ( is -> is_exhausted ) {
+    return false ;
+  }
+  size_t const keep = is -> is_marked ? is -> mark : is -> position ;
+  memmove ( is -> chars , is -> chars + keep , is -> size - keep ) ;
+  is -> size -= keep ;
+  is -> position -= keep ;
+  is -> mark -= is -> is_marked ? keep : 0 ;
+  if ( is -> size == is -> capacity ) {
+    is -> capacity *= 2 ;
+    is -> chars = ( char * ) realloc ( is -> chars , is -> capacity ) ;
+    assert ( NULL != is -> chars ) ;
+  }
+  size_t const read = fread ( is -> chars + is -> size , sizeof ( char ) , is -> capacity - is -> size , is -> f ) ;
+  if ( 0 == read ) {
+    is -> is_exhausted = true ;
+    return false ;
+  }
+  is -> size += read ;
+  return true ;
+}
+
+
+input_source input_source_create ( FILE * f ) {
+  assert ( NULL != f ) ;
+  input_source is = ( input_source ) malloc ( sizeof ( struct input_source_struct ) ) ;
+  assert ( NULL != is ) ;
+  is -> f = f ;
+  is -> position = 0 ;
+  is -> mark = 0 ;
+  is -> is_marked = false ;
+  is -> mapping = NULL ;
+  is -> mapping_size = 0 ;
+  if ( ! input_source_map ( is ) ) {
+    is -> capacity = INPUT_SOURCE_BLOCK_SIZE ;
+    is -> chars = ( char * ) malloc ( is -> capacity ) ;
+    assert ( NULL != is -> chars ) ;
+    is -> size = 0 ;
+    is -> is_exhausted = false ;
+  }
+  return is ;
+}
+
+
+void input_source_destroy ( input_source is ) {
+  assert ( NULL != is ) ;
+# ifndef INPUT_SOURCE_NO_MMAP
+  if ( NULL != is -> mapping ) {
+    munmap ( is -> mapping , is -> mapping_size ) ;
+  } else {
+    free ( is -> chars ) ;
+  }
+# else
+  free ( is -> chars ) ;
+# endif
+  free ( is ) ;
+}
+
+
+int input_source_get ( input_source is ) {
+  assert ( NULL != is ) ;
+  return input_source_refill ( is )
+    ? ( unsigned char ) is -> chars [ is -> position ++ ]
+    : EOF ;
+}
+
+
+int input_source_peek ( input_source is ) {
+  assert ( NULL != is ) ;
+  return input_source_refill ( is )
+    ? ( unsigned char ) is -> chars [ is -> position ]
+    : EOF ;
+}
+
+
+void input_source_skip_class ( input_source is ,
+			       unsigned char const * classes ,
+			       unsigned char mask ) {
+  assert ( NULL != is ) ;
+  assert ( NULL != classes ) ;
+  bool const skip_blanks = 0 != ( classes [ ' ' ] & mask ) ;
+  uint64_t const blanks = UINT64_C ( 0x2020202020202020 ) ;
+  do {
+    char const * p = is -> chars + is -> position ;
+    char const * const end = is -> chars + is -> size ;
+    while ( p < end ) {
+      uint64_t word ;
+      if ( skip_blanks
+	   && ( ( size_t ) ( end - p ) >= sizeof ( word ) )
+	   && ( memcpy ( & word , p , sizeof ( word ) ) , blanks == word ) ) {
+	p += sizeof ( word ) ;
+      } else if ( 0 != ( classes [ ( unsigned char ) * p ] & mask ) ) {
+	p ++ ;
+      } else {
+	break ;
+      }
+    }
+    is -> position = p - is -> chars ;
+  } while ( ( is -> position == is -> size ) && input_source_refill ( is ) ) ;
+}
+
+
+void input_source_skip_to ( input_source is ,
+			    char c1 ,
+			    char c2 ) {
+  assert ( NULL != is ) ;
+  do {
+    char const * const p = is -> chars + is -> position ;
+    size_t length = is -> size - is -> position ;
+    char const * const found_1 = ( char const * ) memchr ( p , c1 , length ) ;
+    if ( NULL != found_1 ) {
+      length = found_1 - p ;
+    }
+    char const * const found_2 = ( char const * ) memchr ( p , c2 , length ) ;
+    if ( NULL != found_2 ) {
+      length = found_2 - p ;
+    }
+    is -> position += length ;
+  } while ( ( is -> position == is -> size ) && input_source_refill ( is ) ) ;
+}
+
+
+void input_source_mark ( input_source is ) {
+  assert ( NULL != is ) ;
+  is -> mark = is -> position ;
+  is -> is_marked = true ;
+}
+
+
+char const * input_source_get_marked ( input_source is ,
+				       unsigned int * length ) {
+  assert ( NULL != is ) ;
+  assert ( is -> is_marked ) ;
+  assert ( NULL != length ) ;
+  * length = is -> position - is -> mark ;
+  return is -> chars + is -> mark ;
+}
@@ -0,0 +1,136 @@
+# ifndef __INPUT_SOURCE_H
+# define __INPUT_SOURCE_H
+
+# include <stdio.h>
+
+
+/*!
+ * \file
+ * \brief Source of the program text read by \link read_chunk_io() \endlink.
+ *
+ * If the stream is a regular file, the whole file is mapped in memory (\c mmap) and read directly from the mapping.
+ * Otherwise (pipe, terminal…), it is read by large blocks (\link INPUT_SOURCE_BLOCK_SIZE \endlink) into a buffer.
+ * In both cases, reading a \c char is an access to memory (there is no call to \c getc).
+ *
+ * A position can be marked (typically the beginning of a token) so that the \c char's read since then can be accessed in place with \link input_source_get_marked() \endlink.
+ * Tokens are thus sliced directly out of the mapping (or buffer) without being copied \c char by \c char.
+ *
+ * If \c INPUT_SOURCE_NO_MMAP is defined at compilation, regular files are also read by blocks.
+ *
+ * The stream is not closed by \c input_source.
+ *
+ * assert is enforced.
+ *
+ * \author Jérôme DURAND-LOSE
+ * \version 1
+ * \date 2015
+ * \copyright GNU Public License.
+ */
+
+
+/*! Size of the blocks read when the stream is not mapped. */
+# define INPUT_SOURCE_BLOCK_SIZE ( 1 << 16 )
+
+
+/*!
+ * \c input_source is a pointer to a hidden structure.
+ */
+typedef struct input_source_struct * input_source ;
+
+
+/*!
+ * Generate an \c input_source reading a stream from its current position.
+ *
+ * \param f stream to read from
+ * \pre \c f is not \c NULL (assert-ed)
+ * \return a new \c input_source
+ */
+extern input_source input_source_create ( FILE * f ) ;
+
+
+/*!
+ * Destroy an \c input_source (the mapping or the buffer is released, the stream is left open).
+ *
+ * \param is \c input_source to destroy
+ * \pre \c is is valid (assert-ed)
+ */
+extern void input_source_destroy ( input_source is ) ;
+
+
+/*!
+ * Read the next \c char.
+ *
+ * \param is \c input_source to read from
+ * \pre \c is is valid (assert-ed)
+ * \return the \c char read (as an \c unsigned \c char) or \c EOF if there is no more \c char
+ */
+extern int input_source_get ( input_source is ) ;
+
+
+/*!
+ * Get the next \c char without reading it.
+ *
+ * \param is \c input_source to query
+ * \pre \c is is valid (assert-ed)
+ * \return the next \c char (as an \c unsigned \c char) or \c EOF if there is no more \c char
+ */
+extern int input_source_peek ( input_source is ) ;
+
+
+/*!
+ * Skip all the \c char's whose class (in \c classes) has some bit of \c mask set.
+ *
+ * The \c char's are scanned directly in memory.
+ * If blanks (\c ' ') are skipped, runs of blanks are skipped by whole machine words.
+ *
+ * \param is \c input_source to read from
+ * \param classes class of each \c char (indexed as \c unsigned \c char)
+ * \param mask bits of the classes to skip
+ * \pre \c is is valid (assert-ed)
+ * \pre \c classes is not \c NULL (assert-ed)
+ */
+extern void input_source_skip_class ( input_source is ,
+				      unsigned char const * classes ,
+				      unsigned char mask ) ;
+
+
+/*!
+ * Skip all the \c char's up to the first \c c1 or \c c2 (excluded) or up to the end.
+ *
+ * The search is done with \c memchr (vectorized by the C library).
+ *
+ * \param is \c input_source to read from
+ * \param c1 first \c char to stop at
+ * \param c2 second \c char to stop at
+ * \pre \c is is valid (assert-ed)
+ */
+extern void input_source_skip_to ( input_source is ,
+				   char c1 ,
+				   char c2 ) ;
+
+
+/*!
+ * Mark the current position (the previous mark is forgotten).
+ *
+ * \param is \c input_source to mark
+ * \pre \c is is valid (assert-ed)
+ */
+extern void input_source_mark ( input_source is ) ;
+
+
+/*!
+ * Access the \c char's read since the mark.
+ *
+ * This is not a copy: the \c char's are only valid until the next call to any other function on \c is.
+ *
+ * \param is \c input_source to query
+ * \param length set to the number of \c char's read since the mark
+ * \pre \c is is valid and marked (assert-ed)
+ * \pre \c length is not \c NULL (assert-ed)
+ * \return the \c char's read since the mark (not \c '\0' terminated)
+ */
+extern char const * input_source_get_marked ( input_source is ,
+					      unsigned int * length ) ;
+
+
+# endif
@@ -1,10 +1,24 @@
+# define _POSIX_C_SOURCE 200809L   // getrlimit
+
+# include <stdlib.h>
 # include <stdio.h>
 # include <assert.h>
+# include <stdint.h>
+# include <sys/resource.h>
 
 
 # include "value.h"
 # include "operator.h"
 
+# include "value_error.h"
+# include "value_boolean.h"
+# include "value_int.h"
+# include "value_block.h"
+# include "value_protected_label.h"
+# include "operator_label.h"
+# include "read_chunk_io.h"
+# include "bytecode.h"
+
 # include "interpreter.h"
 
 
@@ -14,13 +28,957 @@
 
 
 
+void interprete_print_stack ( interpretation_context ic ,
+			      FILE * f ) {
+  assert ( NULL != ic ) ;
+  assert ( NULL != f ) ;
+  fputs ( "vvvvvvvv stack  top  vvvvvvvvvv\n" , f ) ;
+  chunk_stack_print ( ic -> stack , f ) ;
+  fputs ( "^^^^^^^^ stack bottom ^^^^^^^^^\n" , f ) ;
+}
+
+
+/*!
+ * Trace the reading of a \c chunk (if it is not \c NULL).
+ */
+static void interprete_trace_reading ( chunk const ch ) {
+  if ( NULL != ch ) {
+    fputs ( "==**== reading: " , stdout ) ;
+    chunk_print ( ch , stdout ) ;
+    fputs ( chunk_is_value ( ch ) ? " (value)\n" : " (operator)\n" , stdout ) ;
+  }
+}
+
+
+/*!
+ * Maximal number of nested evaluations of \c operator's by the tree-walking interpreter.
+ * It keeps the C stack below the usual 8 MB in optimized and debug builds, and makes the limit the same for all of them.
+ */
+# define INTERPRETER_MAX_DEPTH 20000
+
+/*! C stack available to the tree-walking interpreter if the limit of the process is unknown or unlimited. */
+# define INTERPRETER_DEFAULT_STACK_BUDGET ( 6 << 20 )
+
+
+/*!
+ * C stack available to the tree-walking interpreter: 3/4 of the limit of the process.
+ * The rest is left to the deepest evaluations and to the report of the error.
+ */
+static size_t interprete_stack_budget ( void ) {
+  struct rlimit rl ;
+  if ( ( 0 != getrlimit ( RLIMIT_STACK , & rl ) )
+       || ( RLIM_INFINITY == rl . rlim_cur ) ) {
+    return INTERPRETER_DEFAULT_STACK_BUDGET ;
+  }
+  return ( size_t ) ( rl . rlim_cur / 4 * 3 ) ;
+}
+
+
+/*!
+ * Whether an \c operator may not be evaluated because it would be nested too deeply.
+ * The number of nested evaluations is bounded by \link INTERPRETER_MAX_DEPTH \endlink.
+ * The C stack used since \link interprete() \endlink started is also bounded, for builds with larger frames (f.e. the trace of the virtual machine unoptimized or with sanitizers).
+ */
+static bool interprete_is_too_deep ( interpretation_context ic ) {
+  if ( INTERPRETER_MAX_DEPTH <= ic -> depth ) {
+    return true ;
+  }
+  if ( 0 == ic -> stack_base ) {
+    return false ;
+  }
+  char here ;
+  uintptr_t const top = ( uintptr_t ) & here ;
+  size_t const used = ( top < ic -> stack_base )
+    ? ic -> stack_base - top
+    : top - ic -> stack_base ;
+  return ic -> stack_budget < used ;
+}
+
+
+/*!
+ * Report the error of an \c operator: the \c value_error on top of the stack is printed (and destroyed) and then the stack.
+ */
+static void interprete_report_error ( chunk const ch ,
+				      interpretation_context ic ) {
+  chunk const error = chunk_stack_pop ( ic -> stack ) ;
+  assert ( NULL != error ) ;
+  assert ( value_is_error ( error ) ) ;
+  fputs ( "### ERROR ### operator " , stderr ) ;
+  chunk_print ( ch , stderr ) ;
+  fputs ( " ###  " , stderr ) ;
+  chunk_print ( error , stderr ) ;
+  fputc ( '\n' , stderr ) ;
+  chunk_destroy ( error ) ;
+  interprete_print_stack ( ic , stderr ) ;
+}
+
+
+/*!
+ * Evaluate an \c operator (profiled if requested) and report its error if it fails.
+ * If it is nested too deeply (see \link interprete_is_too_deep() \endlink), it is not evaluated and fails with \c VALUE_ERROR_TOO_DEEP.
+ */
+static void interprete_operator ( chunk const ch ,
+				  interpretation_context ic ) {
+  if ( NULL != ic -> profile ) {
+    profiler_enter ( ic -> profile , ch ) ;
+  }
+  basic_type result ;
+  if ( interprete_is_too_deep ( ic ) ) {
+    result = operator_error ( ic , VALUE_ERROR_TOO_DEEP ) ;
+  } else {
+    ic -> depth ++ ;
+    result = operator_evaluate ( ch , ic ) ;
+    ic -> depth -- ;
+  }
+  if ( basic_type_is_error ( result ) ) {
+    interprete_report_error ( ch , ic ) ;
+  }
+  if ( NULL != ic -> profile ) {
+    profiler_leave ( ic -> profile ) ;
+  }
+}
+
+
 void interprete_chunk ( chunk ch ,
-			interpretation_context ic )  {}
+			interpretation_context ic )  {
+  assert ( NULL != ch ) ;
+  assert ( NULL != ic ) ;
+  if ( ic -> do_trace ) {
+    interprete_trace_reading ( ch ) ;
+  }
+  if ( chunk_is_value ( ch ) ) {
+    chunk_stack_push ( ic -> stack , ch ) ;
+  } else {
+    interprete_operator ( ch , ic ) ;
+    chunk_destroy ( ch ) ;
+  }
+  if ( ic -> do_trace ) {
+    interprete_print_stack ( ic , stdout ) ;
+  }
+}
 
-void interprete_chunk_list ( linked_list_chunk ch ,
-			     interpretation_context ic )  {}
 
-void interprete ( FILE * f ,
-		  bool do_trace )  {}
+/*!
+ * Interpret a borrowed \c chunk: as \link interprete_chunk() \endlink, except that a \c value is copied to be stacked and an \c operator is not destroyed.
+ */
+static void interprete_chunk_borrowed ( chunk const ch ,
+					interpretation_context ic ) {
+  if ( ic -> do_trace ) {
+    interprete_trace_reading ( ch ) ;
+  }
+  if ( chunk_is_value ( ch ) ) {
+    chunk_stack_push ( ic -> stack , chunk_copy ( ch ) ) ;
+  } else {
+    interprete_operator ( ch , ic ) ;
+  }
+  if ( ic -> do_trace ) {
+    interprete_print_stack ( ic , stdout ) ;
+  }
+}
+
+
+/*!
+ * The virtual machine uses computed \c goto's (threaded dispatch, a GNU extension) unless \c INTERPRETER_NO_COMPUTED_GOTO is defined at compilation.
+ * Otherwise (or with another compiler), it uses a \c switch.
+ */
+# if defined ( __GNUC__ ) && ! defined ( INTERPRETER_NO_COMPUTED_GOTO )
+# define INTERPRETER_COMPUTED_GOTO
+# endif
+
+
+# ifdef INTERPRETER_COMPUTED_GOTO
+
+/*! Entry of the dispatch table of an opcode. */
+# define INTERPRETER_TARGET( opcode )		\
+  [ BYTECODE_ ## opcode ] = && interprete_ ## opcode
+
+/*! Beginning of the code of an opcode. */
+# define INTERPRETER_CASE( opcode )		\
+  interprete_ ## opcode
+
+/*! Jump to the code of the current instruction. */
+# define INTERPRETER_DISPATCH()			\
+  goto * interprete_dispatch_table [ ip -> opcode ]
+
+/*! Beginning of the instructions. */
+# define INTERPRETER_BEGIN			\
+  INTERPRETER_DISPATCH () ;			\
+  {
+
+/*! End of the instructions. */
+# define INTERPRETER_END			\
+  }
+
+# else
+
+# define INTERPRETER_CASE( opcode )		\
+  case BYTECODE_ ## opcode
+
+# define INTERPRETER_DISPATCH()			\
+  continue
+
+# define INTERPRETER_BEGIN			\
+  for ( ; ; )					\
+    switch ( ip -> opcode ) {
+
+# define INTERPRETER_END			\
+  }
+
+# endif
+
+
+/*!
+ * End of an instruction that cannot change the tracing (nor run any code): the next instruction is executed.
+ */
+# define INTERPRETER_NEXT			\
+  {						\
+    ip ++ ;					\
+    INTERPRETER_DISPATCH () ;			\
+  }
+
+
+/*!
+ * End of an instruction that may have run some code: the stack is traced (if tracing), then the next instruction is executed (as its \c chunk's if tracing).
+ */
+# define INTERPRETER_NEXT_CHECKED			\
+  {							\
+    if ( ic -> do_trace ) {				\
+      interprete_print_stack ( ic , stdout ) ;		\
+    }							\
+    ip ++ ;						\
+    if ( ic -> do_trace ) {				\
+      goto interprete_traced ;				\
+    }							\
+    INTERPRETER_DISPATCH () ;				\
+  }
+
+
+/*!
+ * Integer fast path of a binary \c operator (given by its opcode): if both operands are immediate \c value_int's and the result is defined, they are replaced by the result (see \link interprete_int_operation() \endlink).
+ * Otherwise, the \c operator is evaluated as usual (so that an overflow is reported as by the \c operator).
+ */
+# define INTERPRETER_INT_OPERATION( operation )			\
+  {									\
+    chunk const ch2 = chunk_stack_nth ( ic -> stack , 0 ) ;		\
+    chunk const ch1 = chunk_stack_nth ( ic -> stack , 1 ) ;		\
+    if ( ( CHUNK_TAG_INT == chunk_get_tag ( ch1 ) )			\
+	 && ( CHUNK_TAG_INT == chunk_get_tag ( ch2 ) ) ) {		\
+      chunk const result =						\
+	interprete_int_operation ( operation ,				\
+				   chunk_immediate_get_payload ( ch1 ) , \
+				   chunk_immediate_get_payload ( ch2 ) ) ; \
+      if ( NULL != result ) {						\
+	chunk_stack_pop ( ic -> stack ) ;				\
+	chunk_stack_pop ( ic -> stack ) ;				\
+	chunk_stack_push ( ic -> stack , result ) ;			\
+	INTERPRETER_NEXT ;						\
+      }									\
+    }									\
+    goto interprete_evaluate ;						\
+  }
+
+
+/*!
+ * Arithmetic operation or comparison (given by its opcode) of two integers.
+ *
+ * \return the result, or \c NULL if it overflows
+ */
+static chunk interprete_int_operation ( bytecode_opcode const operation ,
+					long long int const a ,
+					long long int const b ) {
+  long long int result ;
+  switch ( operation ) {
+  case BYTECODE_ADDITION :
+    return __builtin_add_overflow ( a , b , & result ) ? NULL : value_int_create ( result ) ;
+  case BYTECODE_SUBTRACTION :
+    return __builtin_sub_overflow ( a , b , & result ) ? NULL : value_int_create ( result ) ;
+  case BYTECODE_MULTIPLICATION :
+    return __builtin_mul_overflow ( a , b , & result ) ? NULL : value_int_create ( result ) ;
+  case BYTECODE_LESS :
+    return value_boolean_create ( a < b ) ;
+  case BYTECODE_LESS_EQUAL :
+    return value_boolean_create ( a <= b ) ;
+  case BYTECODE_EQUAL :
+    return value_boolean_create ( a == b ) ;
+  case BYTECODE_DIFFERENT :
+    return value_boolean_create ( a != b ) ;
+  default :
+    assert ( false ) ;
+    return NULL ;
+  }
+}
+
+
+/*!
+ * Comparison (given by its opcode) of two integers.
+ */
+static bool interprete_int_compare ( bytecode_opcode const operation ,
+				     long long int const a ,
+				     long long int const b ) {
+  switch ( operation ) {
+  case BYTECODE_LESS :
+    return a < b ;
+  case BYTECODE_LESS_EQUAL :
+    return a <= b ;
+  case BYTECODE_EQUAL :
+    return a == b ;
+  case BYTECODE_DIFFERENT :
+    return a != b ;
+  default :
+    assert ( false ) ;
+    return false ;
+  }
+}
+
+
+/*!
+ * Whether a \c chunk is a \c value_block (\c NULL is not).
+ */
+static bool interprete_is_block ( chunk const ch ) {
+  return ( NULL != ch ) && value_is_block ( ch ) ;
+}
+
+
+/*!
+ * Whether a \c chunk is a \c value_boolean (\c NULL is not).
+ */
+static bool interprete_is_boolean ( chunk const ch ) {
+  return ( NULL != ch ) && value_is_boolean ( ch ) ;
+}
+
+
+/*!
+ * Value of a \c value_boolean.
+ */
+static bool interprete_get_boolean ( chunk const ch ) {
+  return basic_type_get_boolean ( value_get_value ( ch ) ) ;
+}
+
+
+/*!
+ * Start running the current code: as its \c chunk's if tracing, directly otherwise.
+ */
+# define INTERPRETER_ENTER			\
+  {						\
+    if ( ic -> do_trace ) {			\
+      goto interprete_traced ;			\
+    }						\
+    INTERPRETER_DISPATCH () ;			\
+  }
 
 
+/*!
+ * What is to be done when the code run from a frame returns.
+ */
+typedef enum {
+  INTERPRETER_FRAME_CALL ,            /*!< complete the calling instruction */
+  INTERPRETER_FRAME_WHILE_CONDITION , /*!< test the condition of the \c while and run its body or complete it */
+  INTERPRETER_FRAME_WHILE_BODY        /*!< run the condition of the \c while again */
+} interprete_frame_kind ;
+
+
+/*!
+ * Continuation of the virtual machine: the code to come back to.
+ *
+ * \param kind what to do when the code run from the frame returns
+ * \param code code to come back to
+ * \param ip instruction of \c code that made the frame (\c if, \c while, label…)
+ * \param block \c value_block of \c code, owned by the frame (\c NULL if \c code is borrowed)
+ * \param pending number of tail calls of \c code that are completed when it returns
+ * \param cond condition of a \c while (owned by the frame)
+ * \param body body of a \c while (owned by the frame)
+ */
+typedef struct {
+  interprete_frame_kind kind ;
+  bytecode code ;
+  bytecode_instruction const * ip ;
+  chunk block ;
+  unsigned int pending ;
+  chunk cond ;
+  chunk body ;
+} interprete_frame ;
+
+
+/*!
+ * Stack of frames of the virtual machine (allocated on the first call).
+ */
+typedef struct {
+  unsigned int size ;
+  unsigned int capacity ;
+  interprete_frame * frames ;
+} interprete_frame_stack ;
+
+
+/*! Initial capacity of a stack of frames. */
+# define INTERPRETER_FRAMES_CAPACITY 16
+
+
+/*!
+ * Push a new frame (to be filled).
+ */
+static interprete_frame * interprete_frame_push ( interprete_frame_stack * const fs ) {
+  if ( fs -> size == fs -> capacity ) {
+    fs -> capacity = ( 0 == fs -> capacity ) ? INTERPRETER_FRAMES_CAPACITY : 2 * fs -> capacity ;
+    fs -> frames = ( interprete_frame * ) realloc ( fs -> frames , fs -> capacity * sizeof ( interprete_frame ) ) ;
+    assert ( NULL != fs -> frames ) ;
+  }
+  return fs -> frames + fs -> size ++ ;
+}
+
+
+/*!
+ * Virtual machine: run a \c bytecode in a context.
+ *
+ * Each instruction does exactly what \link interprete_chunk() \endlink does with its \c chunk's, but the \c chunk's are not consumed: \c value's are copied and \c operator's are borrowed.
+ * The most frequent cases are handled directly (integer arithmetic and comparisons, \c if, \c if_else and \c while on \c value_block's, superinstructions, folded branches).
+ * Otherwise, the \c operator is evaluated as usual.
+ *
+ * When tracing (or when a superinstruction does not apply to the operands), the instruction is executed as its \c chunk's with \link interprete_chunk_borrowed() \endlink, so that the trace is exactly the one of the \c chunk's.
+ * Fused comparisons with \c if or \c if_else are the exception: only the comparison is evaluated as usual, the branch is then handled as by \c if or \c if_else (so that it is not run recursively).
+ *
+ * The \c value_block's run by \c if, \c if_else, \c while and labels (and their superinstructions) are not run recursively: the code to come back to is saved on an explicit stack of frames.
+ * A call that is the last instruction of a code is a tail call: it replaces the current code instead of pushing a frame.
+ * So a label that calls itself last runs in constant native stack and frame stack.
+ * In order to trace faithfully when tracing is turned on during a tail call, the number of calls completed by each return is counted.
+ *
+ * Other \c operator's (and everything when tracing) may still run \c value_block's recursively.
+ */
+# ifdef INTERPRETER_COMPUTED_GOTO
+# pragma GCC diagnostic push
+# pragma GCC diagnostic ignored "-Wpedantic"
+# endif
+static void interprete_bytecode ( bytecode const root ,
+				  interpretation_context ic ) {
+# ifdef INTERPRETER_COMPUTED_GOTO
+  static void * const interprete_dispatch_table [ BYTECODE_OPCODE_NUMBER ] = {
+    INTERPRETER_TARGET ( PUSH ) ,
+    INTERPRETER_TARGET ( ADDITION ) ,
+    INTERPRETER_TARGET ( SUBTRACTION ) ,
+    INTERPRETER_TARGET ( MULTIPLICATION ) ,
+    INTERPRETER_TARGET ( DIVISION ) ,
+    INTERPRETER_TARGET ( REMAINDER ) ,
+    INTERPRETER_TARGET ( LESS ) ,
+    INTERPRETER_TARGET ( LESS_EQUAL ) ,
+    INTERPRETER_TARGET ( EQUAL ) ,
+    INTERPRETER_TARGET ( DIFFERENT ) ,
+    INTERPRETER_TARGET ( AND ) ,
+    INTERPRETER_TARGET ( OR ) ,
+    INTERPRETER_TARGET ( NOT ) ,
+    INTERPRETER_TARGET ( NOP ) ,
+    INTERPRETER_TARGET ( POP ) ,
+    INTERPRETER_TARGET ( PRINT ) ,
+    INTERPRETER_TARGET ( COPY ) ,
+    INTERPRETER_TARGET ( DEF ) ,
+    INTERPRETER_TARGET ( IF ) ,
+    INTERPRETER_TARGET ( IF_ELSE ) ,
+    INTERPRETER_TARGET ( WHILE ) ,
+    INTERPRETER_TARGET ( LABEL ) ,
+    INTERPRETER_TARGET ( PRINT_STACK ) ,
+    INTERPRETER_TARGET ( PRINT_DICTIONARY ) ,
+    INTERPRETER_TARGET ( START_TRACE ) ,
+    INTERPRETER_TARGET ( STOP_TRACE ) ,
+    INTERPRETER_TARGET ( OPERATOR ) ,
+    INTERPRETER_TARGET ( INCREMENT_LABEL ) ,
+    INTERPRETER_TARGET ( COPY_CONSTANT ) ,
+    INTERPRETER_TARGET ( OPERATION_CONSTANT ) ,
+    INTERPRETER_TARGET ( COMPARE_IF ) ,
+    INTERPRETER_TARGET ( COMPARE_IF_ELSE ) ,
+    INTERPRETER_TARGET ( RUN_BLOCK ) ,
+    INTERPRETER_TARGET ( RETURN )
+  } ;
+# endif
+  bytecode bc = root ;
+  bytecode_instruction const * ip = bc -> instructions ;
+  chunk block = NULL ;
+  unsigned int pending = 0 ;
+  interprete_frame_stack fs = { .size = 0 , .capacity = 0 , .frames = NULL } ;
+  chunk callee ;
+  bool callee_owned ;
+  chunk branch ;
+  if ( ic -> do_trace ) {
+    goto interprete_traced ;
+  }
+
+  INTERPRETER_BEGIN
+
+  INTERPRETER_CASE ( PUSH ) :
+    chunk_stack_push ( ic -> stack , chunk_copy ( ip -> ch ) ) ;
+    INTERPRETER_NEXT ;
+
+  INTERPRETER_CASE ( ADDITION ) :
+    INTERPRETER_INT_OPERATION ( BYTECODE_ADDITION ) ;
+
+  INTERPRETER_CASE ( SUBTRACTION ) :
+    INTERPRETER_INT_OPERATION ( BYTECODE_SUBTRACTION ) ;
+
+  INTERPRETER_CASE ( MULTIPLICATION ) :
+    INTERPRETER_INT_OPERATION ( BYTECODE_MULTIPLICATION ) ;
+
+  INTERPRETER_CASE ( LESS ) :
+    INTERPRETER_INT_OPERATION ( BYTECODE_LESS ) ;
+
+  INTERPRETER_CASE ( LESS_EQUAL ) :
+    INTERPRETER_INT_OPERATION ( BYTECODE_LESS_EQUAL ) ;
+
+  INTERPRETER_CASE ( EQUAL ) :
+    INTERPRETER_INT_OPERATION ( BYTECODE_EQUAL ) ;
+
+  INTERPRETER_CASE ( DIFFERENT ) :
+    INTERPRETER_INT_OPERATION ( BYTECODE_DIFFERENT ) ;
+
+  INTERPRETER_CASE ( NOP ) :
+    INTERPRETER_NEXT ;
+
+  INTERPRETER_CASE ( IF ) :
+    branch = ip -> ch ;
+  interprete_if : {
+    chunk const cond = chunk_stack_nth ( ic -> stack , 0 ) ;
+    chunk const code = chunk_stack_nth ( ic -> stack , 1 ) ;
+    if ( ! ( interprete_is_boolean ( cond ) && interprete_is_block ( code ) ) ) {
+      goto interprete_evaluate_branch ;
+    }
+    bool const b = interprete_get_boolean ( cond ) ;
+    chunk_destroy ( chunk_stack_pop ( ic -> stack ) ) ;
+    chunk_stack_pop ( ic -> stack ) ;
+    if ( ! b ) {
+      chunk_destroy ( code ) ;
+      INTERPRETER_NEXT ;
+    }
+    callee = code ;
+    callee_owned = true ;
+    goto interprete_call ;
+  }
+
+  INTERPRETER_CASE ( IF_ELSE ) :
+    branch = ip -> ch ;
+  interprete_if_else : {
+    chunk const cond = chunk_stack_nth ( ic -> stack , 0 ) ;
+    chunk const code_true = chunk_stack_nth ( ic -> stack , 1 ) ;
+    chunk const code_false = chunk_stack_nth ( ic -> stack , 2 ) ;
+    if ( ! ( interprete_is_boolean ( cond )
+	     && interprete_is_block ( code_true )
+	     && interprete_is_block ( code_false ) ) ) {
+      goto interprete_evaluate_branch ;
+    }
+    bool const b = interprete_get_boolean ( cond ) ;
+    chunk_destroy ( chunk_stack_pop ( ic -> stack ) ) ;
+    chunk_stack_pop ( ic -> stack ) ;
+    chunk_stack_pop ( ic -> stack ) ;
+    chunk_destroy ( b ? code_false : code_true ) ;
+    callee = b ? code_true : code_false ;
+    callee_owned = true ;
+    goto interprete_call ;
+  }
+
+  INTERPRETER_CASE ( WHILE ) : {
+    chunk const cond = chunk_stack_nth ( ic -> stack , 0 ) ;
+    chunk const body = chunk_stack_nth ( ic -> stack , 1 ) ;
+    if ( ! ( interprete_is_block ( cond ) && interprete_is_block ( body ) ) ) {
+      goto interprete_evaluate ;
+    }
+    chunk_stack_pop ( ic -> stack ) ;
+    chunk_stack_pop ( ic -> stack ) ;
+    interprete_frame * const f = interprete_frame_push ( & fs ) ;
+    * f = ( interprete_frame ) {
+      .kind = INTERPRETER_FRAME_WHILE_CONDITION ,
+      .code = bc ,
+      .ip = ip ,
+      .block = block ,
+      .pending = pending ,
+      .cond = cond ,
+      .body = body } ;
+    bc = value_block_get_bytecode ( cond ) ;
+    ip = bc -> instructions ;
+    block = NULL ;
+    pending = 0 ;
+    INTERPRETER_ENTER ;
+  }
+
+  INTERPRETER_CASE ( DIVISION ) :
+  INTERPRETER_CASE ( REMAINDER ) :
+  INTERPRETER_CASE ( AND ) :
+  INTERPRETER_CASE ( OR ) :
+  INTERPRETER_CASE ( NOT ) :
+  INTERPRETER_CASE ( POP ) :
+  INTERPRETER_CASE ( PRINT ) :
+  INTERPRETER_CASE ( COPY ) :
+  INTERPRETER_CASE ( DEF ) :
+  INTERPRETER_CASE ( PRINT_STACK ) :
+  INTERPRETER_CASE ( PRINT_DICTIONARY ) :
+  INTERPRETER_CASE ( START_TRACE ) :
+  INTERPRETER_CASE ( STOP_TRACE ) :
+  INTERPRETER_CASE ( OPERATOR ) :
+  interprete_evaluate :
+    if ( basic_type_is_error ( operator_evaluate ( ip -> ch , ic ) ) ) {
+      interprete_report_error ( ip -> ch , ic ) ;
+    }
+    INTERPRETER_NEXT_CHECKED ;
+
+  /*
+   * The if or if_else branch (the last chunk of a fused comparison) does not apply to the operands: it is evaluated as usual.
+   */
+  interprete_evaluate_branch :
+    if ( basic_type_is_error ( operator_evaluate ( branch , ic ) ) ) {
+      interprete_report_error ( branch , ic ) ;
+    }
+    INTERPRETER_NEXT_CHECKED ;
+
+  /*
+   * A fused comparison does not apply to the operands: the comparison is evaluated as usual and the result goes to the if or if_else, so that the branch taken is still run from a frame (or as a tail call).
+   * Since a comparison runs no code, tracing is still off.
+   */
+  interprete_compare_evaluate : {
+    chunk const compare = bc -> chunks [ ip -> source + ip -> span - 2 ] ;
+    if ( ip -> has_constant ) {
+      chunk_stack_push ( ic -> stack , value_int_create ( ip -> constant ) ) ;
+    }
+    if ( basic_type_is_error ( operator_evaluate ( compare , ic ) ) ) {
+      interprete_report_error ( compare , ic ) ;
+    }
+    branch = bc -> chunks [ ip -> source + ip -> span - 1 ] ;
+    if ( BYTECODE_COMPARE_IF == ip -> opcode ) {
+      goto interprete_if ;
+    }
+    goto interprete_if_else ;
+  }
+
+  INTERPRETER_CASE ( INCREMENT_LABEL ) : {
+    dictionary_slot const slot = dictionary_get_slot ( ic -> dic , ip -> sy ) ;
+    if ( ( NULL == slot )
+	 || ( CHUNK_TAG_INT != chunk_get_tag ( dictionary_slot_get_borrowed ( slot ) ) ) ) {
+      goto interprete_span ;
+    }
+    chunk const val = value_int_create ( chunk_immediate_get_payload ( dictionary_slot_get_borrowed ( slot ) )
+					 + ip -> constant ) ;
+    dictionary_set_symbol ( ic -> dic , ip -> sy , val ) ;
+    chunk_destroy ( val ) ;
+    bytecode_fusion_counts [ BYTECODE_INCREMENT_LABEL ] ++ ;
+    INTERPRETER_NEXT ;
+  }
+
+  INTERPRETER_CASE ( COPY_CONSTANT ) : {
+    unsigned int const size = chunk_stack_size ( ic -> stack ) ;
+    chunk_stack_dup_n ( ic -> stack , ( ip -> constant < size ) ? ( unsigned int ) ip -> constant : size ) ;
+    bytecode_fusion_counts [ BYTECODE_COPY_CONSTANT ] ++ ;
+    INTERPRETER_NEXT ;
+  }
+
+  INTERPRETER_CASE ( OPERATION_CONSTANT ) : {
+    chunk const top = chunk_stack_peek ( ic -> stack ) ;
+    if ( CHUNK_TAG_INT != chunk_get_tag ( top ) ) {
+      goto interprete_span ;
+    }
+    chunk const result = interprete_int_operation ( ip -> operation ,
+						    chunk_immediate_get_payload ( top ) ,
+						    ip -> constant ) ;
+    if ( NULL == result ) {
+      goto interprete_span ;
+    }
+    chunk_stack_pop ( ic -> stack ) ;
+    chunk_stack_push ( ic -> stack , result ) ;
+    bytecode_fusion_counts [ BYTECODE_OPERATION_CONSTANT ] ++ ;
+    INTERPRETER_NEXT ;
+  }
+
+  INTERPRETER_CASE ( COMPARE_IF ) : {
+    unsigned int const depth = ip -> has_constant ? 0 : 1 ;
+    chunk const ch1 = chunk_stack_nth ( ic -> stack , depth ) ;
+    chunk const ch2 = ip -> has_constant ? NULL : chunk_stack_nth ( ic -> stack , 0 ) ;
+    chunk const code = chunk_stack_nth ( ic -> stack , depth + 1 ) ;
+    if ( ! ( ( CHUNK_TAG_INT == chunk_get_tag ( ch1 ) )
+	     && ( ip -> has_constant || ( CHUNK_TAG_INT == chunk_get_tag ( ch2 ) ) )
+	     && interprete_is_block ( code ) ) ) {
+      goto interprete_compare_evaluate ;
+    }
+    bytecode_fusion_counts [ BYTECODE_COMPARE_IF ] ++ ;
+    bool const b = interprete_int_compare ( ip -> operation ,
+					    chunk_immediate_get_payload ( ch1 ) ,
+					    ip -> has_constant ? ip -> constant : chunk_immediate_get_payload ( ch2 ) ) ;
+    for ( unsigned int i = 0 ; i <= depth ; i ++ ) {
+      chunk_stack_pop ( ic -> stack ) ;
+    }
+    chunk_stack_pop ( ic -> stack ) ;
+    if ( ! b ) {
+      chunk_destroy ( code ) ;
+      INTERPRETER_NEXT ;
+    }
+    callee = code ;
+    callee_owned = true ;
+    goto interprete_call ;
+  }
+
+  INTERPRETER_CASE ( COMPARE_IF_ELSE ) : {
+    unsigned int const depth = ip -> has_constant ? 0 : 1 ;
+    chunk const ch1 = chunk_stack_nth ( ic -> stack , depth ) ;
+    chunk const ch2 = ip -> has_constant ? NULL : chunk_stack_nth ( ic -> stack , 0 ) ;
+    chunk const code_true = chunk_stack_nth ( ic -> stack , depth + 1 ) ;
+    chunk const code_false = chunk_stack_nth ( ic -> stack , depth + 2 ) ;
+    if ( ! ( ( CHUNK_TAG_INT == chunk_get_tag ( ch1 ) )
+	     && ( ip -> has_constant || ( CHUNK_TAG_INT == chunk_get_tag ( ch2 ) ) )
+	     && interprete_is_block ( code_true )
+	     && interprete_is_block ( code_false ) ) ) {
+      goto interprete_compare_evaluate ;
+    }
+    bytecode_fusion_counts [ BYTECODE_COMPARE_IF_ELSE ] ++ ;
+    bool const b = interprete_int_compare ( ip -> operation ,
+					    chunk_immediate_get_payload ( ch1 ) ,
+					    ip -> has_constant ? ip -> constant : chunk_immediate_get_payload ( ch2 ) ) ;
+    for ( unsigned int i = 0 ; i <= depth ; i ++ ) {
+      chunk_stack_pop ( ic -> stack ) ;
+    }
+    chunk_stack_pop ( ic -> stack ) ;
+    chunk_stack_pop ( ic -> stack ) ;
+    chunk_destroy ( b ? code_false : code_true ) ;
+    callee = b ? code_true : code_false ;
+    callee_owned = true ;
+    goto interprete_call ;
+  }
+
+  INTERPRETER_CASE ( LABEL ) : {
+    chunk const val = operator_label_get_borrowed ( ip -> ch , ic ) ;
+    if ( NULL == val ) {
+      goto interprete_evaluate ;
+    }
+    if ( ! value_is_block ( val ) ) {
+      chunk_stack_push ( ic -> stack , chunk_copy ( val ) ) ;
+      INTERPRETER_NEXT ;
+    }
+    callee = chunk_copy ( val ) ;
+    callee_owned = true ;
+    goto interprete_call ;
+  }
+
+  INTERPRETER_CASE ( RUN_BLOCK ) :
+    callee = ip -> ch ;
+    callee_owned = false ;
+    goto interprete_call ;
+
+  /*
+   * Run the value_block callee (owned or borrowed from the current code).
+   * The callee is kept alive by the frames: it is owned or it is borrowed from a code that is.
+   */
+  interprete_call : {
+    bytecode const callee_code = value_block_get_bytecode ( callee ) ;
+    if ( BYTECODE_RETURN == ( ip + 1 ) -> opcode ) {
+      // Tail call: the current code is done
+      if ( ( ! callee_owned ) && ( NULL != block ) ) {
+	callee = chunk_copy ( callee ) ;
+	callee_owned = true ;
+      }
+      if ( NULL != block ) {
+	chunk_destroy ( block ) ;
+      }
+      pending ++ ;
+    } else {
+      interprete_frame * const f = interprete_frame_push ( & fs ) ;
+      * f = ( interprete_frame ) {
+	.kind = INTERPRETER_FRAME_CALL ,
+	.code = bc ,
+	.ip = ip ,
+	.block = block ,
+	.pending = pending } ;
+      pending = 0 ;
+    }
+    bc = callee_code ;
+    ip = bc -> instructions ;
+    block = callee_owned ? callee : NULL ;
+    INTERPRETER_ENTER ;
+  }
+
+  interprete_traced :
+    if ( BYTECODE_RETURN == ip -> opcode ) {
+      goto interprete_return ;
+    }
+  interprete_span :
+    for ( unsigned int i = 0 ; i < ip -> span ; i ++ ) {
+      interprete_chunk_borrowed ( bc -> chunks [ ip -> source + i ] , ic ) ;
+    }
+    ip ++ ;
+    if ( ic -> do_trace ) {
+      goto interprete_traced ;
+    }
+    INTERPRETER_DISPATCH () ;
+
+  INTERPRETER_CASE ( RETURN ) :
+  interprete_return : {
+    if ( ic -> do_trace ) {
+      for ( ; 0 < pending ; pending -- ) {
+	interprete_print_stack ( ic , stdout ) ;
+      }
+    }
+    if ( NULL != block ) {
+      chunk_destroy ( block ) ;
+    }
+    if ( 0 == fs . size ) {
+      free ( fs . frames ) ;
+      return ;
+    }
+    interprete_frame * const f = fs . frames + fs . size - 1 ;
+    if ( INTERPRETER_FRAME_WHILE_BODY == f -> kind ) {
+      f -> kind = INTERPRETER_FRAME_WHILE_CONDITION ;
+      bc = value_block_get_bytecode ( f -> cond ) ;
+      ip = bc -> instructions ;
+      block = NULL ;
+      pending = 0 ;
+      INTERPRETER_ENTER ;
+    }
+    if ( INTERPRETER_FRAME_WHILE_CONDITION == f -> kind ) {
+      chunk const test = chunk_stack_peek ( ic -> stack ) ;
+      if ( ! interprete_is_boolean ( test ) ) {
+	operator_error ( ic , ( NULL == test ) ? VALUE_ERROR_EMPTY_STACK : VALUE_ERROR_ILLEGAL_OPERAND ) ;
+	interprete_report_error ( f -> ip -> ch , ic ) ;
+      } else {
+	bool const b = interprete_get_boolean ( test ) ;
+	chunk_destroy ( chunk_stack_pop ( ic -> stack ) ) ;
+	if ( b ) {
+	  f -> kind = INTERPRETER_FRAME_WHILE_BODY ;
+	  bc = value_block_get_bytecode ( f -> body ) ;
+	  ip = bc -> instructions ;
+	  block = NULL ;
+	  pending = 0 ;
+	  INTERPRETER_ENTER ;
+	}
+      }
+      chunk_destroy ( f -> cond ) ;
+      chunk_destroy ( f -> body ) ;
+    }
+    fs . size -- ;
+    bc = f -> code ;
+    ip = f -> ip ;
+    block = f -> block ;
+    pending = f -> pending ;
+    INTERPRETER_NEXT_CHECKED ;
+  }
+
+# ifndef INTERPRETER_COMPUTED_GOTO
+  case BYTECODE_OPCODE_NUMBER :
+    assert ( false ) ;
+# endif
+
+  INTERPRETER_END
+}
+# ifdef INTERPRETER_COMPUTED_GOTO
+# pragma GCC diagnostic pop
+# endif
+
+
+void interprete_chunk_list ( linked_list_chunk llc ,
+			     interpretation_context ic )  {
+  assert ( NULL != llc ) ;
+  assert ( NULL != ic ) ;
+  chunk ch ;
+  while ( NULL != ( ch = linked_list_chunk_pop_front ( llc ) ) ) {
+    interprete_chunk ( ch , ic ) ;
+  }
+}
+
+
+void interprete_chunk_list_borrowed ( linked_list_chunk llc ,
+				      interpretation_context ic )  {
+  assert ( NULL != llc ) ;
+  assert ( NULL != ic ) ;
+  for ( linked_list_chunk_cursor cur = linked_list_chunk_cursor_first ( llc ) ;
+	NULL != cur ;
+	cur = linked_list_chunk_cursor_next ( cur ) ) {
+    interprete_chunk_borrowed ( linked_list_chunk_cursor_get ( cur ) , ic ) ;
+  }
+}
+
+
+void interprete_block_borrowed ( chunk vb ,
+			       interpretation_context ic ) {
+  assert ( NULL != vb ) ;
+  assert ( NULL != ic ) ;
+  if ( ic -> use_bytecode ) {
+    interprete_bytecode ( value_block_get_bytecode ( vb ) , ic ) ;
+  } else {
+    interprete_chunk_list_borrowed ( value_block_peek_list ( vb ) , ic ) ;
+  }
+}
+
+
+void interprete_value ( chunk ch ,
+			interpretation_context ic ) {
+  assert ( NULL != ch ) ;
+  assert ( NULL != ic ) ;
+  if ( value_is_block ( ch ) ) {
+    interprete_block_borrowed ( ch , ic ) ;
+    chunk_destroy ( ch ) ;
+  } else if ( value_is_protected_label ( ch ) ) {
+    chunk const label = operator_label_create_symbol ( value_protected_label_get_symbol ( ch ) ) ;
+    chunk_destroy ( ch ) ;
+    interprete_chunk ( label , ic ) ;
+  } else {
+    interprete_chunk ( ch , ic ) ;
+  }
+}
+
+
+void interprete_value_borrowed ( chunk ch ,
+				 interpretation_context ic ) {
+  assert ( NULL != ch ) ;
+  assert ( NULL != ic ) ;
+  if ( value_is_block ( ch ) ) {
+    interprete_block_borrowed ( ch , ic ) ;
+  } else {
+    interprete_value ( chunk_copy ( ch ) , ic ) ;
+  }
+}
+
+
+void interprete ( FILE * f ,
+		  bool do_trace ,
+		  bool use_bytecode ,
+		  bool do_profile ,
+		  FILE * folded )  {
+  assert ( NULL != f ) ;
+  char stack_base ;
+  bool const is_profiled = do_profile || ( NULL != folded ) ;
+  use_bytecode = use_bytecode && ! is_profiled ;
+  interpretation_context_struct ic = {
+    .program_input_stream = input_source_create ( f ) ,
+    .stack = chunk_stack_create () ,
+    .dic = dictionary_create () ,
+    .do_trace = do_trace ,
+    .use_bytecode = use_bytecode ,
+    .profile = is_profiled ? profiler_create () : NULL ,
+    .depth = 0 ,
+    .stack_base = ( uintptr_t ) & stack_base ,
+    .stack_budget = interprete_stack_budget () } ;
+  chunk ch ;
+  if ( use_bytecode ) {
+    linked_list_chunk const program = linked_list_chunk_create () ;
+    while ( ! value_is_error ( ch = read_chunk_io ( ic . program_input_stream ) ) ) {
+      linked_list_chunk_add_back ( program , ch ) ;
+    }
+    interprete_value ( value_block_create ( program ) , & ic ) ;
+  } else {
+    while ( ! value_is_error ( ch = read_chunk_io ( ic . program_input_stream ) ) ) {
+      interprete_chunk ( ch , & ic ) ;
+    }
+  }
+  if ( VALUE_ERROR_IO_EOF != basic_type_get_long_long_int ( value_get_value ( ch ) ) ) {
+    fputs ( "### ERROR ### reading ###  " , stderr ) ;
+    chunk_print ( ch , stderr ) ;
+    fputc ( '\n' , stderr ) ;
+  }
+  chunk_destroy ( ch ) ;
+  if ( do_trace ) {
+    puts ( "======= dictionnary ==============" ) ;
+    dictionary_print ( ic . dic , stdout ) ;
+  }
+  puts ( "======== final stack =============" ) ;
+  chunk_stack_print ( ic . stack , stdout ) ;
+  if ( do_profile ) {
+    profiler_print ( ic . profile , stderr ) ;
+  }
+  if ( NULL != folded ) {
+    profiler_print_folded ( ic . profile , folded ) ;
+  }
+  if ( is_profiled ) {
+    profiler_destroy ( ic . profile ) ;
+  }
+  chunk_stack_destroy ( ic . stack ) ;
+  dictionary_destroy ( ic . dic ) ;
+  input_source_destroy ( ic . program_input_stream ) ;
+}
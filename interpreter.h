@@ -2,9 +2,13 @@
 # define __INTERPRETER_H
 
 # include <stdio.h>
+# include <stdint.h>
 
 # include "linked_list_chunk.h"
+# include "chunk_stack.h"
 # include "dictionary.h"
+# include "input_source.h"
+# include "profiler.h"
 
 
 /*! 
@@ -19,12 +23,22 @@
  * \param stack current stack
  * \param dic \c dictionary used to store ( label , value )
  * \param do_trace if true then the execution should be traces (otherwise no)
+ * \param use_bytecode if true then \c value_block's are compiled to \c bytecode and run by the virtual machine (otherwise their lists are walked)
+ * \param profile where the evaluations of \c operator's are recorded, \c NULL if not profiling
+ * \param depth number of nested evaluations of \c operator's by \link interprete_chunk() \endlink (bounded, see there)
+ * \param stack_base address in the C stack where the interpretation started, 0 if the C stack is not checked
+ * \param stack_budget C stack that the nested evaluations may use
  */
 typedef struct interpretation_context_struct {
-  FILE * program_input_stream ;
-  linked_list_chunk stack ;
+  input_source program_input_stream ;
+  chunk_stack stack ;
   dictionary dic ;
   bool do_trace ;
+  bool use_bytecode ;
+  profiler profile ;
+  unsigned int depth ;
+  uintptr_t stack_base ;
+  size_t stack_budget ;
 } interpretation_context_struct ,
   * interpretation_context ;
 
@@ -41,6 +55,11 @@ typedef struct interpretation_context_struct {
  vvvvvvvv stack  top  vvvvvvvvvv
  ^^^^^^^^ stack bottom ^^^^^^^^^
  \endverbatim
+ *
+ * The tree-walking interpreter recurses on the C stack (f.e. a label whose body calls it again).
+ * So that a deep recursion is reported instead of overflowing the C stack, an \c operator is not evaluated beyond 20000 nested evaluations (or 3/4 of the C stack limit of the process, whichever comes first): it fails with \c VALUE_ERROR_TOO_DEEP.
+ * The virtual machine has its own stack of frames and is not limited (except by memory).
+ *
  * \param ch \c chunk to interpret
  * \param ic contest to interpret it
  * \pre no pointer is NULL
@@ -63,18 +82,111 @@ extern void interprete_chunk_list ( linked_list_chunk llc ,
 				    interpretation_context ic ) ;
 
 
+/*! 
+ * Interpret a borrowed list of chunk in a context.
+ * They are all interpreted in sequence by iterating over the list with a cursor.
+ * Only the \c value's are copied (to be stacked), the \c operator's are evaluated in place.
+ *
+ * The linked_list_chunk is not modified (so it must not be modified nor destroyed during the interpretation).
+ *
+ * \param llc \c chunk list to interpret
+ * \param ic contest to interpret it
+ * \pre no pointer is NULL
+ */
+extern void interprete_chunk_list_borrowed ( linked_list_chunk llc ,
+					     interpretation_context ic ) ;
+
+
+/*! 
+ * Interpret a borrowed \c value_block in a context.
+ * Its \c bytecode is run by the virtual machine (if \c use_bytecode is set) or its list is interpreted with \link interprete_chunk_list_borrowed() \endlink.
+ *
+ * The \c value_block is not modified (so it must not be modified nor destroyed during the interpretation).
+ *
+ * \param vb \c value_block to interpret
+ * \param ic contest to interpret it
+ * \pre no pointer is NULL
+ */
+extern void interprete_block_borrowed ( chunk vb ,
+				       interpretation_context ic ) ;
+
+
+/*! 
+ * Interpret a \c value as code (used by \c operator's such as \c if and \c while).
+ * \li if it is a \c value_block, its \c chunk's are interpreted in order (the block is not emptied, see \link interprete_block_borrowed() \endlink);
+ * \li if it is a \c value_protected_label, it is interpreted as the corresponding \c operator_label;
+ * \li otherwise, it is interpreted as usual (i.e. stacked).
+ *
+ * The \c value is consumed (i.e. destroyed or stacked).
+ *
+ * \param ch \c value to interpret
+ * \param ic contest to interpret it
+ * \pre no pointer is NULL
+ */
+extern void interprete_value ( chunk ch ,
+			       interpretation_context ic ) ;
+
+
+/*! 
+ * Interpret a borrowed \c value as code, as \link interprete_value() \endlink does, but without consuming it (it is only copied if it is stacked).
+ * This is meant for code run repeatedly (such as the body of a \c while).
+ *
+ * The \c value is not modified (so it must not be modified nor destroyed during the interpretation).
+ *
+ * \param ch \c value to interpret
+ * \param ic contest to interpret it
+ * \pre no pointer is NULL
+ */
+extern void interprete_value_borrowed ( chunk ch ,
+					interpretation_context ic ) ;
+
+
+/*! 
+ * Print the stack of a context between delimiters as follows:
+ * \verbatim
+ vvvvvvvv stack  top  vvvvvvvvvv
+ ^^^^^^^^ stack bottom ^^^^^^^^^
+ \endverbatim
+ *
+ * \param ic context whose stack is printed
+ * \param f stream to print to
+ * \pre no pointer is NULL
+ */
+extern void interprete_print_stack ( interpretation_context ic ,
+				     FILE * f ) ;
+
+
 /*! 
  * Interpret a program from a stream.
  * As long as the stream is not empty, \c chunk are read and interpreted.
  *
  * The interpretation starts with an empty stack and an empty dictionary.
+ * The stream is read through an \c input_source (mapped if it is a regular file).
+ * It is not closed.
+ *
+ * With \c use_bytecode, the whole program is read first and then run as a \c value_block by the virtual machine.
+ * Otherwise, each \c chunk is interpreted as soon as it is read (tree-walking interpretation).
+ *
+ * If reading fails (f.e. a syntax error), the reading error is reported on \c stderr after the \c chunk's read before it are interpreted, and the rest of the stream is ignored.
+ * Both produce then the same outputs on \c stdout.
+ * But with \c use_bytecode, nothing is interpreted before the end of the stream (or a reading error) is reached, so that the outputs do not start as soon as they could (f.e. when the program is typed in), and the whole program is kept in memory (as \c chunk's and as bytecode) while it runs.
+ *
+ * With \c do_profile, each evaluation of an \c operator is recorded by a \c profiler and the profile is printed on \c stderr at the end (see \link profiler_print() \endlink).
+ * With \c folded, the time spent in each call chain is printed on it at the end, as folded stacks for \c flamegraph.pl (see \link profiler_print_folded() \endlink).
+ * In both cases, the program is tree-walked (the virtual machine does not evaluate the \c chunk's one by one), so that nothing is done for profiling otherwise.
  *
  * \param input steam to read the program from
  * \param do_trace if true then the execution should be traces (otherwise no)
- * \pre no pointer is NULL
+ * \param use_bytecode if true then the program is run by the virtual machine (otherwise it is tree-walked)
+ * \param do_profile if true then the execution is profiled (and tree-walked)
+ * \param folded stream to print the folded stacks to (then the execution is profiled and tree-walked), \c NULL for none
+ * \pre \c input is not NULL
  */
 extern void interprete ( FILE * input ,
-			 bool do_trace ) ;
+			 bool do_trace ,
+			 bool use_bytecode ,
+			 bool do_profile ,
+			 FILE * folded ) ;
 
 
 
@@ -134,4 +134,43 @@ extern bool linked_list_chunk_add_self_copy_front ( linked_list_chunk llc ,
  */extern linked_list_chunk linked_list_chunk_copy ( linked_list_chunk llc ) ;
 
 
+/*!
+ * A cursor is a read-only position in a \c linked_list_chunk.
+ * It remains valid as long as the list is not modified.
+ * \c NULL is used for the end of the list.
+ */
+typedef struct link_struct const * linked_list_chunk_cursor ;
+
+
+/*!
+ * Cursor on the first \c chunk of a \c linked_list_chunk.
+ *
+ * \param llc \c linked_list_chunk to walk
+ * \pre \c llc is valid (assert-ed)
+ * \return a cursor on the first \c chunk or \c NULL if \c llc is empty
+ */
+extern linked_list_chunk_cursor linked_list_chunk_cursor_first ( linked_list_chunk llc ) ;
+
+
+/*!
+ * Cursor on the next \c chunk.
+ *
+ * \param cur cursor to advance
+ * \pre \c cur is not \c NULL (assert-ed)
+ * \return a cursor on the next \c chunk or \c NULL at the end of the list
+ */
+extern linked_list_chunk_cursor linked_list_chunk_cursor_next ( linked_list_chunk_cursor cur ) ;
+
+
+/*!
+ * The \c chunk at a cursor.
+ * It is \b not a copy, it still belongs to the list.
+ *
+ * \param cur cursor to read from
+ * \pre \c cur is not \c NULL (assert-ed)
+ * \return the \c chunk at the cursor
+ */
+extern chunk linked_list_chunk_cursor_get ( linked_list_chunk_cursor cur ) ;
+
+
 # endif
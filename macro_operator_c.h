@@ -1,9 +1,18 @@
 # ifndef __MACRO_OPERATOR_C_H
 # define __MACRO_OPERATOR_C_H
 
+# include <limits.h>
 
 # include "value_error.h"
 
+# include "chunk_pool.h"
+# include "chunk_stack.h"
+
+# include "value_int.h"
+# include "value_double.h"
+# include "value_sstring.h"
+# include "value_boolean.h"
+
 # undef OPERATOR_DECLARE
 
 # define OPERATOR_DECLARE( type_name )				\
@@ -25,68 +34,361 @@
 									\
   									\
   static basic_type operator_ ## op_name ## _print ( chunk const ch ,	\
-						     va_list va ) {	\
-    return basic_type_erreur ;						\
+						     FILE * const f ) {	\
+    fputs ( # op , f ) ;						\
+    return basic_type_void ;						\
   }									\
 									\
-  static basic_type operator_ ## op_name ## _destroy ( chunk const ch ,	\
-						       va_list va ) {	\
-    return basic_type_erreur ;						\
+  static basic_type operator_ ## op_name ## _destroy ( chunk const ch ) { \
+    return basic_type_void ;						\
   }									\
 									\
-  static basic_type operator_ ## op_name ## _copy ( chunk const ch ,	\
-						    va_list va ) {	\
-    return basic_type_void ;						\
+  static chunk operator_ ## op_name ## _copy ( chunk const ch ) {	\
+    return ch ;								\
   }									\
 									\
   static const message_action operator_ ## op_name ## _reactions [] = {	\
-    MESSAGE_ACTION__BASIC_OPERATOR( op_name ) ,				\
+    MESSAGE_ACTION__BASIC_OPERATOR ,					\
     { NULL, NULL }							\
   } ;									\
 									\
+  static const chunk_vtable operator_ ## op_name ## _vtable = {		\
+    CHUNK_VTABLE__BASIC_OPERATOR( op_name )				\
+  } ;									\
+									\
   static chunk_struct operator_ ## op_name ## _instance = {		\
     .state = NULL ,							\
-    .reactions = operator_ ## op_name ## _reactions  } ;		\
+    .reactions = operator_ ## op_name ## _reactions ,			\
+    .vtable = & operator_ ## op_name ## _vtable } ;			\
   									\
   chunk operator_ ## op_name ## _create () {				\
-    return NULL ;                                                       \
+    return & operator_ ## op_name ## _instance ;			\
   }									\
 									\
   bool operator_is_ ## op_name ( chunk const ch ) {			\
-    return true ;                               			\
+    assert ( NULL != ch ) ;						\
+    return operator_ ## op_name ## _reactions == chunk_header ( ch ) -> reactions ; \
   }
 
 
 
-# define OPERATOR_NUMBER( op_name , op )				\
-  static basic_type operator_ ## op_name ## _operate ( chunk const ch ,	\
-						       va_list va ) {	\
-    return basic_type_error ;						\
+/*!
+ * Allocate the \c chunk of an \c operator with a state (i.e. not a static instance), of type <tt>operator_ ## op_name ## _state_struct</tt>, as a single block from \c chunk_pool.
+ * \c reactions and \c vtable are set, the state is left to be initialized.
+ */
+# define OPERATOR_CHUNK_ALLOCATE( op_name )				\
+  chunk_pool_allocate ( operator_ ## op_name ## _reactions ,		\
+			& operator_ ## op_name ## _vtable ,		\
+			sizeof ( operator_ ## op_name ## _state_struct ) )
+
+
+/*!
+ * Release a \c chunk (state included) allocated with \link OPERATOR_CHUNK_ALLOCATE \endlink.
+ */
+# define OPERATOR_CHUNK_RELEASE( op_name , ch )				\
+  chunk_pool_release ( ( ch ) ,						\
+		       sizeof ( operator_ ## op_name ## _state_struct ) )
+
+
+
+/*!
+ * Kinds of operands of the arithmetic and comparison \c operator's (indexes of their dispatch tables).
+ */
+typedef enum {
+  OPERATOR_KIND_OTHER = 0 ,
+  OPERATOR_KIND_INT ,
+  OPERATOR_KIND_DOUBLE ,
+  OPERATOR_KIND_SSTRING ,
+  OPERATOR_KIND_BOOLEAN ,
+  OPERATOR_KIND_NUMBER       /*!< number of kinds (not a kind) */
+} operator_kind ;
+
+
+/*!
+ * Kind of an operand (immediates are recognized by their tag only).
+ */
+static inline operator_kind operator_kind_of ( chunk const ch ) {
+  switch ( chunk_get_tag ( ch ) ) {
+  case CHUNK_TAG_INT :
+    return OPERATOR_KIND_INT ;
+  case CHUNK_TAG_BOOLEAN :
+    return OPERATOR_KIND_BOOLEAN ;
+  default :
+    return value_is_int ( ch ) ? OPERATOR_KIND_INT
+      : value_is_double ( ch ) ? OPERATOR_KIND_DOUBLE
+      : value_is_sstring ( ch ) ? OPERATOR_KIND_SSTRING
+      : OPERATOR_KIND_OTHER ;
   }
+}
+
+
+/*!
+ * Specialized code of a binary \c operator for a pair of kinds of operands: \c ch1 (under) and \c ch2 (top) are replaced by the result.
+ */
+typedef basic_type ( * operator_kernel ) ( interpretation_context ic ,
+					   chunk const ch1 ,
+					   chunk const ch2 ) ;
+
+
+/*!
+ * Header of the kernel of \c op_name for the kinds \c kinds (f.e. \c int_double).
+ */
+# define OPERATOR_KERNEL( op_name , kinds )				\
+  static basic_type operator_ ## op_name ## _ ## kinds ( interpretation_context ic , \
+							 chunk const ch1 , \
+							 chunk const ch2 )
+
 
+/*!
+ * Get the value of a \c value_int (immediate or not).
+ */
+# define OPERATOR_GET_INT( ch )						\
+  ( ( CHUNK_TAG_INT == chunk_get_tag ( ch ) )				\
+    ? chunk_immediate_get_payload ( ch )				\
+    : basic_type_get_long_long_int ( value_get_value ( ch ) ) )
+
+
+/*!
+ * Get the value of a \c value_double.
+ */
+# define OPERATOR_GET_DOUBLE( ch )					\
+  basic_type_get_float ( value_get_value ( ch ) )
+
+
+/*!
+ * Get the \c sstring of a \c value_sstring.
+ */
+# define OPERATOR_GET_SSTRING( ch )					\
+  ( ( sstring ) basic_type_get_pointer ( value_get_value ( ch ) ) )
+
+
+/*!
+ * Integer operation <tt>v1 op v2</tt> where \c op is the first \c char of the \c operator (\c +, \c -, \c *, \c / or \c %).
+ * The result is stored in \c * result unless it is not defined: overflow, division by 0, or \c LLONG_MIN divided by -1.
+ * Since \c op is a constant in the kernels, the \c switch is resolved at compilation.
+ *
+ * \return true iff the result is defined
+ */
+static inline bool operator_int_arithmetic ( char const op ,
+					     long long int const v1 ,
+					     long long int const v2 ,
+					     long long int * const result ) {
+  switch ( op ) {
+  case '+' :
+    return ! __builtin_add_overflow ( v1 , v2 , result ) ;
+  case '-' :
+    return ! __builtin_sub_overflow ( v1 , v2 , result ) ;
+  case '*' :
+    return ! __builtin_mul_overflow ( v1 , v2 , result ) ;
+  case '/' :
+  case '%' :
+    if ( ( 0 == v2 ) || ( ( LLONG_MIN == v1 ) && ( -1 == v2 ) ) ) {
+      return false ;
+    }
+    * result = ( '/' == op ) ? v1 / v2 : v1 % v2 ;
+    return true ;
+  default :
+    assert ( false ) ;
+    return false ;
+  }
+}
+
+
+/*!
+ * Checks that there are (at least) two \c chunk's on the stack.
+ * They are available as \c ch1 (under) and \c ch2 (top).
+ */
+# define OPERATOR_GET_TWO_OPERANDS( ic )				\
+  chunk const ch2 = chunk_stack_nth ( ( ic ) -> stack , 0 ) ;		\
+  chunk const ch1 = chunk_stack_nth ( ( ic ) -> stack , 1 ) ;		\
+  if ( NULL == ch1 ) {							\
+    return operator_error ( ( ic ) , VALUE_ERROR_EMPTY_STACK ) ;	\
+  }
+
+
+/*!
+ * Evaluation of a binary \c operator through its dispatch table <tt>operator_ ## op_name ## _kernels</tt>: the kernel is selected by the kinds of the operands.
+ * Pairs without kernel are an error.
+ */
+# define OPERATOR_DISPATCH( op_name )					\
+  static basic_type operator_ ## op_name ## _evaluate ( chunk const ch , \
+							interpretation_context ic ) { \
+    OPERATOR_GET_TWO_OPERANDS( ic ) ;					\
+    operator_kernel const kernel =					\
+      operator_ ## op_name ## _kernels [ operator_kind_of ( ch1 ) ] [ operator_kind_of ( ch2 ) ] ; \
+    if ( NULL == kernel ) {						\
+      return operator_error ( ic , VALUE_ERROR_ILLEGAL_OPERAND ) ;	\
+    }									\
+    return kernel ( ic , ch1 , ch2 ) ;					\
+  }
+
+
+/*!
+ * Kernels of <tt>ch1 op ch2</tt> on numbers when (at least) one of them is a \c value_double (the result is made by \c create).
+ */
+# define OPERATOR_MIXED_KERNELS( op_name , op , create )		\
+  OPERATOR_KERNEL( op_name , int_double ) {				\
+    return operator_replace_top ( ic , 2 ,				\
+				  create ( ( basic_float ) OPERATOR_GET_INT ( ch1 ) \
+					   op OPERATOR_GET_DOUBLE ( ch2 ) ) ) ; \
+  }									\
+									\
+  OPERATOR_KERNEL( op_name , double_int ) {				\
+    return operator_replace_top ( ic , 2 ,				\
+				  create ( OPERATOR_GET_DOUBLE ( ch1 )	\
+					   op ( basic_float ) OPERATOR_GET_INT ( ch2 ) ) ) ; \
+  }									\
+									\
+  OPERATOR_KERNEL( op_name , double_double ) {				\
+    return operator_replace_top ( ic , 2 ,				\
+				  create ( OPERATOR_GET_DOUBLE ( ch1 )	\
+					   op OPERATOR_GET_DOUBLE ( ch2 ) ) ) ; \
+  }
+
+
+/*!
+ * Entries of a dispatch table for the kernels of \link OPERATOR_MIXED_KERNELS \endlink and the \c int_int one.
+ */
+# define OPERATOR_NUMBER_ENTRIES( op_name )				\
+  [ OPERATOR_KIND_INT ] [ OPERATOR_KIND_INT ] = operator_ ## op_name ## _int_int , \
+  [ OPERATOR_KIND_INT ] [ OPERATOR_KIND_DOUBLE ] = operator_ ## op_name ## _int_double , \
+  [ OPERATOR_KIND_DOUBLE ] [ OPERATOR_KIND_INT ] = operator_ ## op_name ## _double_int , \
+  [ OPERATOR_KIND_DOUBLE ] [ OPERATOR_KIND_DOUBLE ] = operator_ ## op_name ## _double_double
+
+
+/*!
+ * Kernel of <tt>ch1 op ch2</tt> on \c value_int's: an undefined result is an error.
+ */
+# define OPERATOR_INT_KERNEL( op_name , op )				\
+  OPERATOR_KERNEL( op_name , int_int ) {				\
+    long long int result ;						\
+    if ( ! operator_int_arithmetic ( ( # op ) [ 0 ] ,			\
+				     OPERATOR_GET_INT ( ch1 ) ,		\
+				     OPERATOR_GET_INT ( ch2 ) ,		\
+				     & result ) ) {			\
+      return operator_error ( ic , VALUE_ERROR_ILLEGAL_OPERAND ) ;	\
+    }									\
+    return operator_replace_top ( ic , 2 , value_int_create ( result ) ) ; \
+  }
+
+
+/*!
+ * Arithmetic \c operator: <tt>ch1 op ch2</tt> on numbers.
+ * The result is a \c value_int iff both are \c value_int, otherwise it is a \c value_double.
+ * Integer division by 0 and integer overflow are errors (see \link operator_int_arithmetic() \endlink).
+ */
+# define OPERATOR_NUMBER( op_name , op )				\
+  OPERATOR_INT_KERNEL( op_name , op )					\
+									\
+  OPERATOR_MIXED_KERNELS( op_name , op , value_double_create )		\
+									\
+  static operator_kernel const operator_ ## op_name ## _kernels [ OPERATOR_KIND_NUMBER ] [ OPERATOR_KIND_NUMBER ] = { \
+    OPERATOR_NUMBER_ENTRIES( op_name )					\
+  } ;									\
+									\
+  OPERATOR_DISPATCH( op_name )						\
+									\
+  OPERATOR_BASIC_FULL( op_name , op )
+
+
+/*!
+ * Integer \c operator: <tt>ch1 op ch2</tt> on \c value_int's only.
+ * A 0 right operand and overflow are errors (see \link operator_int_arithmetic() \endlink).
+ */
+# define OPERATOR_INTEGER( op_name , op )				\
+  OPERATOR_INT_KERNEL( op_name , op )					\
+									\
+  static operator_kernel const operator_ ## op_name ## _kernels [ OPERATOR_KIND_NUMBER ] [ OPERATOR_KIND_NUMBER ] = { \
+    [ OPERATOR_KIND_INT ] [ OPERATOR_KIND_INT ] = operator_ ## op_name ## _int_int \
+  } ;									\
+									\
+  OPERATOR_DISPATCH( op_name )						\
+									\
+  OPERATOR_BASIC_FULL( op_name , op )
+
+
+/*!
+ * Boolean \c operator: <tt>ch1 op ch2</tt> on \c value_boolean's only.
+ */
 # define OPERATOR_BOOLEAN( op_name , op )				\
-  static basic_type operator_ ## op_name ## _operate ( chunk const ch ,	\
-						       va_list va ) {	\
-    return basic_type_error ;						\
+  static basic_type operator_ ## op_name ## _evaluate ( chunk const ch , \
+							interpretation_context ic ) { \
+    OPERATOR_GET_TWO_OPERANDS( ic ) ;					\
+    if ( ! ( value_is_boolean ( ch1 ) && value_is_boolean ( ch2 ) ) ) { \
+      return operator_error ( ic , VALUE_ERROR_ILLEGAL_OPERAND ) ;	\
+    }									\
+    bool const b1 = basic_type_get_boolean ( value_get_value ( ch1 ) ) ; \
+    bool const b2 = basic_type_get_boolean ( value_get_value ( ch2 ) ) ; \
+    return operator_replace_top ( ic , 2 , value_boolean_create ( b1 op b2 ) ) ; \
   }									\
 									\
   OPERATOR_BASIC_FULL( op_name , op )
 
 
+/*!
+ * Kernels of the comparison <tt>ch1 op ch2</tt> on numbers.
+ */
+# define OPERATOR_COMPARE_KERNELS( op_name , op )			\
+  OPERATOR_KERNEL( op_name , int_int ) {				\
+    return operator_replace_top ( ic , 2 ,				\
+				  value_boolean_create ( OPERATOR_GET_INT ( ch1 ) \
+							 op OPERATOR_GET_INT ( ch2 ) ) ) ; \
+  }									\
+									\
+  OPERATOR_MIXED_KERNELS( op_name , op , value_boolean_create )
+
 
+/*!
+ * Comparison \c operator: <tt>ch1 op ch2</tt> on numbers or \c value_sstring's (\c sstring_compare order).
+ */
 # define OPERATOR_COMPARATOR( op_name , op )				\
-  static basic_type operator_ ## op_name ## _operate ( chunk const ch ,	\
-						       va_list va ) {	\
-    return basic_type_error ;						\
-  }
+  OPERATOR_COMPARE_KERNELS( op_name , op )				\
+									\
+  OPERATOR_KERNEL( op_name , sstring_sstring ) {			\
+    return operator_replace_top ( ic , 2 ,				\
+				  value_boolean_create ( sstring_compare ( OPERATOR_GET_SSTRING ( ch1 ) , \
+									   OPERATOR_GET_SSTRING ( ch2 ) ) \
+							 op 0 ) ) ;	\
+  }									\
+									\
+  static operator_kernel const operator_ ## op_name ## _kernels [ OPERATOR_KIND_NUMBER ] [ OPERATOR_KIND_NUMBER ] = { \
+    OPERATOR_NUMBER_ENTRIES( op_name ) ,				\
+    [ OPERATOR_KIND_SSTRING ] [ OPERATOR_KIND_SSTRING ] = operator_ ## op_name ## _sstring_sstring \
+  } ;									\
+									\
+  OPERATOR_DISPATCH( op_name )						\
+									\
+  OPERATOR_BASIC_FULL( op_name , op )
 
 
+/*!
+ * Equality \c operator: <tt>ch1 op ch2</tt> on numbers, \c value_sstring's or \c value_boolean's.
+ * \c value_sstring's hold interned \c sstring's that are tested with \c sstring_equal (i.e. by address).
+ */
 # define OPERATOR_EQUALITY( op_name , op )				\
-  static basic_type operator_ ## op_name ## _operate ( chunk const ch ,	\
-						       va_list va ) {	\
-    return basic_type_error ;					        \
+  OPERATOR_COMPARE_KERNELS( op_name , op )				\
+									\
+  OPERATOR_KERNEL( op_name , sstring_sstring ) {			\
+    return operator_replace_top ( ic , 2 ,				\
+				  value_boolean_create ( sstring_equal ( OPERATOR_GET_SSTRING ( ch1 ) , \
+									 OPERATOR_GET_SSTRING ( ch2 ) ) \
+							 op true ) ) ;	\
+  }									\
+									\
+  OPERATOR_KERNEL( op_name , boolean_boolean ) {			\
+    return operator_replace_top ( ic , 2 ,				\
+				  value_boolean_create ( basic_type_get_boolean ( value_get_value ( ch1 ) ) \
+							 op basic_type_get_boolean ( value_get_value ( ch2 ) ) ) ) ; \
   }									\
 									\
+  static operator_kernel const operator_ ## op_name ## _kernels [ OPERATOR_KIND_NUMBER ] [ OPERATOR_KIND_NUMBER ] = { \
+    OPERATOR_NUMBER_ENTRIES( op_name ) ,				\
+    [ OPERATOR_KIND_SSTRING ] [ OPERATOR_KIND_SSTRING ] = operator_ ## op_name ## _sstring_sstring , \
+    [ OPERATOR_KIND_BOOLEAN ] [ OPERATOR_KIND_BOOLEAN ] = operator_ ## op_name ## _boolean_boolean \
+  } ;									\
+									\
+  OPERATOR_DISPATCH( op_name )						\
+									\
   OPERATOR_BASIC_FULL( op_name , op )
 
 
@@ -2,6 +2,9 @@
 # define __MACRO_VALUE_C_H
 
 
+# include "chunk_pool.h"
+
+
 # undef VALUE_DECLARE
 
 # define VALUE_DECLARE( type_name , type_C )			\
@@ -16,8 +19,25 @@
 # define VALUE_IS_FULL( type_name )					\
   bool value_is_ ## type_name ( chunk const ch ) {			\
     assert ( NULL != ch ) ;						\
-    return value_ ## type_name ## _reactions == ch -> reactions ;	\
+    return value_ ## type_name ## _reactions == chunk_header ( ch ) -> reactions ; \
   }
 
+/*!
+ * Allocate the \c chunk of a \c value together with its state, of type <tt>value_ ## type_name ## _state_struct</tt>, as a single block from \c chunk_pool.
+ * \c reactions and \c vtable are set, the state is left to be initialized.
+ */
+# define VALUE_CHUNK_ALLOCATE( type_name )				\
+  chunk_pool_allocate ( value_ ## type_name ## _reactions ,		\
+			& value_ ## type_name ## _vtable ,		\
+			sizeof ( value_ ## type_name ## _state_struct ) )
+
+
+/*!
+ * Release a \c chunk (state included) allocated with \link VALUE_CHUNK_ALLOCATE \endlink.
+ */
+# define VALUE_CHUNK_RELEASE( type_name , ch )				\
+  chunk_pool_release ( ( ch ) ,						\
+		       sizeof ( value_ ## type_name ## _state_struct ) )
+
 # endif
 
@@ -7,7 +7,7 @@
 
 bool chunk_is_operator ( chunk const ch ) {
   assert ( NULL != ch ) ;
-  return basic_type_is_true ( chunk_answer_message ( ch , MESSAGE_OPERATOR_IS_OPERATOR ) ) ;
+  return NULL != chunk_header ( ch ) -> vtable -> evaluate ;
 }
 
 
@@ -18,11 +18,39 @@ basic_type chunk_is_operator_true ( chunk const ch ,
 }
 
 
+basic_type operator_evaluate_message ( chunk const ch ,
+				       va_list va ) {
+  // no assert because it can only be called by chunk_answer_message
+  interpretation_context ic = va_arg ( va , interpretation_context ) ;
+  return ( * ( chunk_header ( ch ) -> vtable -> evaluate ) ) ( ch , ic ) ;
+}
+
+
 basic_type operator_evaluate ( chunk const ch ,
 			       interpretation_context ic ) {
   assert ( chunk_is_operator ( ch ) ) ;
   assert ( NULL != ic ) ;
-  return chunk_answer_message ( ch , MESSAGE_OPERATOR_EVALUATE , ic ) ;
+  return ( * ( chunk_header ( ch ) -> vtable -> evaluate ) ) ( ch , ic ) ;
+}
+
+
+basic_type operator_error ( interpretation_context ic ,
+			    error_code const code ) {
+  assert ( NULL != ic ) ;
+  chunk_stack_push ( ic -> stack , value_error_create ( code ) ) ;
+  return basic_type_error ;
 }
 
 
+basic_type operator_replace_top ( interpretation_context ic ,
+				  unsigned int const n ,
+				  chunk const result ) {
+  assert ( NULL != ic ) ;
+  assert ( NULL != result ) ;
+  assert ( n <= chunk_stack_size ( ic -> stack ) ) ;
+  for ( unsigned int i = 0 ; i < n ; i ++ ) {
+    chunk_destroy ( chunk_stack_pop ( ic -> stack ) ) ;
+  }
+  chunk_stack_push ( ic -> stack , result ) ;
+  return basic_type_void ;
+}
@@ -6,6 +6,7 @@
 # include "chunk.h"
 
 # include "interpreter.h"
+# include "value_error.h"
 
 
 /*!
@@ -17,6 +18,7 @@
  * A \c chunk is a \c operator if it gives a positive response to the message \link MESSAGE_OPERATOR_IS_OPERATOR \endlink.
  *
  * Any \c operator must also respond to the message \link MESSAGE_OPERATOR_EVALUATE \endlink.
+ * Both are answered through the \c chunk_vtable: a \c chunk is an \c operator iff its \c evaluate entry is set.
  *
  * There is no \c operator_create.
  * This it thought as an abstract intermediary class.
@@ -32,7 +34,7 @@
 
 /*!
  * Test whether a \c chunk is a \c operator.
- * It is done by sending the \link MESSAGE_OPERATOR_IS_OPERATOR \endlink message and decoding the response (or the absence of).
+ * It is done by checking the \c evaluate entry of its \c chunk_vtable (same answer as to the \link MESSAGE_OPERATOR_IS_OPERATOR \endlink message).
  *
  * \param ch \c chunk to test
  * \pre \c ch must not be \c NULL (assert-ed)
@@ -55,7 +57,7 @@ extern basic_type chunk_is_operator_true ( chunk const ch ,
 
 /*!
  * Ask an operator to evaluate it-self.
- * This is done by sending the \link MESSAGE_OPERATOR_EVALUATE\endlink  message together with the \c interpretation_context.
+ * This is done by calling the \c evaluate entry of its \c chunk_vtable with the \c interpretation_context (same answer as to the \link MESSAGE_OPERATOR_EVALUATE\endlink  message).
  *
  * \param ch \c chunk to evaluate
  * \param ic context for the evaluation
@@ -67,6 +69,37 @@ extern basic_type operator_evaluate ( chunk const ch ,
 				      interpretation_context ic ) ;
 
 
+/*!
+ * Report an error from the evaluation of an \c operator:
+ * a \c value_error is pushed on the stack and \c basic_type_error is returned (as expected by \link interprete_chunk() \endlink).
+ * It should be called before any modification of the stack so that the stack is left as it was.
+ *
+ * Typical use is <tt>return operator_error ( ic , VALUE_ERROR_EMPTY_STACK ) ;</tt>
+ *
+ * \param ic context of the evaluation
+ * \param code error code of the \c value_error
+ * \pre \c ic must not be \c NULL (assert-ed)
+ * \return \c basic_type_error
+ */
+extern basic_type operator_error ( interpretation_context ic ,
+				   error_code const code ) ;
+
+
+/*!
+ * Replace some \c chunk's on top of the stack (they are destroyed) by a \c chunk.
+ *
+ * \param ic context of the evaluation
+ * \param n number of \c chunk's to remove
+ * \param result \c chunk pushed afterwards
+ * \pre \c ic and \c result must not be \c NULL (assert-ed)
+ * \pre the stack holds at least \c n \c chunk's (assert-ed)
+ * \return \c basic_type_void
+ */
+extern basic_type operator_replace_top ( interpretation_context ic ,
+					 unsigned int const n ,
+					 chunk const result ) ;
+
+
 /*! Mesage to query whether is is a operator. */
 # define MESSAGE_OPERATOR_IS_OPERATOR "operator_is_operator" 
 
@@ -75,14 +108,34 @@ extern basic_type operator_evaluate ( chunk const ch ,
 # define MESSAGE_OPERATOR_EVALUATE "operator_evaluate" 
 
 
+/*!
+ * Action for \link MESSAGE_OPERATOR_EVALUATE \endlink: forwards to the \c evaluate entry of the \c chunk_vtable.
+ * The \c interpretation_context is the extra argument.
+ * It is shared by all classes.
+ */
+extern basic_type operator_evaluate_message ( chunk const ch ,
+					      va_list va ) ;
+
+
 /*!
  * Enlarged message_action array for \c operator's.
  * Directly set \c chunk_is_operator_true.
  */
-# define MESSAGE_ACTION__BASIC_OPERATOR( type )				\
-  MESSAGE_ACTION__BASIC_PARAM( operator_ , type ) ,			\
+# define MESSAGE_ACTION__BASIC_OPERATOR					\
+  MESSAGE_ACTION__BASIC ,						\
   { MESSAGE_OPERATOR_IS_OPERATOR , & chunk_is_operator_true } ,		\
-  { MESSAGE_OPERATOR_EVALUATE , & operator_ ## type ## _evaluate }
+  { MESSAGE_OPERATOR_EVALUATE , & operator_evaluate_message }
+
+
+/*!
+ * Enlarged \c chunk_vtable entries for \c operator's.
+ * <tt>operator_ ## type ## _evaluate</tt> must be defined with the typed signature.
+ *
+ * \param type to indicate the proper name of the operator type
+ */
+# define CHUNK_VTABLE__BASIC_OPERATOR( type )			\
+  CHUNK_VTABLE__BASIC_PARAM( operator_ , type ) ,		\
+  .evaluate = & operator_ ## type ## _evaluate
 
 
 
@@ -34,6 +34,4 @@
  */
 
 
-OPERATOR_DECLARE ( addition ) 
-
-
+OPERATOR_NUMBER( addition , + )
@@ -30,6 +30,4 @@
  */
 
 
-OPERATOR_DECLARE ( and ) 
-
-
+OPERATOR_BOOLEAN( and , && )
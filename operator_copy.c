@@ -38,7 +38,24 @@
  */
 
 
-OPERATOR_DECLARE ( copy ) 
-
-
-
+static basic_type operator_copy_evaluate ( chunk const ch ,
+					   interpretation_context ic ) {
+  chunk const top = chunk_stack_peek ( ic -> stack ) ;
+  if ( NULL == top ) {
+    return operator_error ( ic , VALUE_ERROR_EMPTY_STACK ) ;
+  }
+  if ( ! value_is_int ( top ) ) {
+    return operator_error ( ic , VALUE_ERROR_ILLEGAL_OPERAND ) ;
+  }
+  long long int const k = basic_type_get_long_long_int ( value_get_value ( top ) ) ;
+  if ( k < 0 ) {
+    return operator_error ( ic , VALUE_ERROR_ILLEGAL_OPERAND ) ;
+  }
+  chunk_destroy ( chunk_stack_pop ( ic -> stack ) ) ;
+  unsigned int const size = chunk_stack_size ( ic -> stack ) ;
+  chunk_stack_dup_n ( ic -> stack , ( k < size ) ? ( unsigned int ) k : size ) ;
+  return basic_type_void ;
+}
+
+
+OPERATOR_BASIC_FULL( copy , copy )
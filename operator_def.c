@@ -32,6 +32,23 @@
  */
 
 
-OPERATOR_DECLARE ( def ) 
-
-
+static basic_type operator_def_evaluate ( chunk const ch ,
+					  interpretation_context ic ) {
+  chunk const label = chunk_stack_nth ( ic -> stack , 0 ) ;
+  chunk const val = chunk_stack_nth ( ic -> stack , 1 ) ;
+  if ( NULL == val ) {
+    return operator_error ( ic , VALUE_ERROR_EMPTY_STACK ) ;
+  }
+  if ( ! value_is_protected_label ( label ) ) {
+    return operator_error ( ic , VALUE_ERROR_ILLEGAL_OPERAND ) ;
+  }
+  dictionary_set_symbol ( ic -> dic ,
+			  value_protected_label_get_symbol ( label ) ,
+			  val ) ;
+  chunk_destroy ( chunk_stack_pop ( ic -> stack ) ) ;
+  chunk_destroy ( chunk_stack_pop ( ic -> stack ) ) ;
+  return basic_type_void ;
+}
+
+
+OPERATOR_BASIC_FULL( def , def )
@@ -33,6 +33,4 @@
  */
 
 
-OPERATOR_DECLARE ( different ) 
-
-
+OPERATOR_EQUALITY( different , != )
@@ -34,7 +34,4 @@
  */
 
 
-OPERATOR_DECLARE ( division ) 
-
-
-
+OPERATOR_NUMBER( division , / )
@@ -33,6 +33,4 @@
  */
 
 
-OPERATOR_DECLARE ( equal ) 
-
-
+OPERATOR_EQUALITY( equal , == )
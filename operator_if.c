@@ -42,6 +42,27 @@
  */
 
 
-OPERATOR_DECLARE ( if ) 
-
-
+static basic_type operator_if_evaluate ( chunk const ch ,
+					 interpretation_context ic ) {
+  chunk const cond = chunk_stack_nth ( ic -> stack , 0 ) ;
+  chunk const code = chunk_stack_nth ( ic -> stack , 1 ) ;
+  if ( NULL == code ) {
+    return operator_error ( ic , VALUE_ERROR_EMPTY_STACK ) ;
+  }
+  if ( ! ( value_is_boolean ( cond )
+	   && ( value_is_block ( code ) || value_is_protected_label ( code ) ) ) ) {
+    return operator_error ( ic , VALUE_ERROR_ILLEGAL_OPERAND ) ;
+  }
+  bool const b = basic_type_get_boolean ( value_get_value ( cond ) ) ;
+  chunk_destroy ( chunk_stack_pop ( ic -> stack ) ) ;
+  chunk_stack_pop ( ic -> stack ) ;
+  if ( b ) {
+    interprete_value ( code , ic ) ;
+  } else {
+    chunk_destroy ( code ) ;
+  }
+  return basic_type_void ;
+}
+
+
+OPERATOR_BASIC_FULL( if , if )
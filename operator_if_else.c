@@ -8,6 +8,7 @@
 
 # include "value_boolean.h"
 # include "value_block.h"
+# include "value_protected_label.h"
 # include "value_error.h"
 
 
@@ -36,7 +37,32 @@
  */
 
 
-OPERATOR_DECLARE ( if_else ) 
-
+static basic_type operator_if_else_evaluate ( chunk const ch ,
+					      interpretation_context ic ) {
+  chunk const cond = chunk_stack_nth ( ic -> stack , 0 ) ;
+  chunk const code_true = chunk_stack_nth ( ic -> stack , 1 ) ;
+  chunk const code_false = chunk_stack_nth ( ic -> stack , 2 ) ;
+  if ( NULL == code_false ) {
+    return operator_error ( ic , VALUE_ERROR_EMPTY_STACK ) ;
+  }
+  if ( ! ( value_is_boolean ( cond )
+	   && ( value_is_block ( code_true ) || value_is_protected_label ( code_true ) )
+	   && ( value_is_block ( code_false ) || value_is_protected_label ( code_false ) ) ) ) {
+    return operator_error ( ic , VALUE_ERROR_ILLEGAL_OPERAND ) ;
+  }
+  bool const b = basic_type_get_boolean ( value_get_value ( cond ) ) ;
+  chunk_destroy ( chunk_stack_pop ( ic -> stack ) ) ;
+  chunk_stack_pop ( ic -> stack ) ;
+  chunk_stack_pop ( ic -> stack ) ;
+  if ( b ) {
+    chunk_destroy ( code_false ) ;
+    interprete_value ( code_true , ic ) ;
+  } else {
+    chunk_destroy ( code_true ) ;
+    interprete_value ( code_false , ic ) ;
+  }
+  return basic_type_void ;
+}
 
 
+OPERATOR_BASIC_FULL( if_else , if_else )
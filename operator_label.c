@@ -21,6 +21,9 @@
  * If the associated \c value is a \c value_block, then the \c chunk's are processed in order.
  * Otherwise, it is processed as usually.
  *
+ * Names are interned as \c symbol's on creation (i.e. at parse time).
+ * Each label caches its slot in the \c dictionary, which is reused as long as the version stamp of the \c dictionary is unchanged.
+ *
  * Label can be created even if the entry is not defined in the dictionary.
  * It should be defined when evaluated.
  * 
@@ -34,21 +37,133 @@
 
 
 /*!
- * Create an \c operator_label.
+ * The symbol of the label and the number of copies sharing it.
  *
- * \param ss non empty string
- * \pre \c ss in not \ NULL and non-empty (assert-ed)
- * \return a newly created \c operator_label
+ * The slot of the symbol in the last \c dictionary used is cached together with the version stamp of the \c dictionary at that time.
+ * As long as the stamp is unchanged, the value is read directly from the slot.
+ */
+typedef struct {
+  unsigned int copies_count ;
+  symbol sy ;
+  dictionary cached_dic ;
+  unsigned long long int cached_version ;
+  dictionary_slot cached_slot ;
+} operator_label_state_struct ,
+  * operator_label_state ;
+
+
+static basic_type operator_label_print ( chunk const ch ,
+					 FILE * const f ) {
+  sstring_print ( symbol_get_name ( ( ( operator_label_state ) ( ch -> state ) ) -> sy ) , f ) ;
+  return basic_type_void ;
+}
+
+
+static basic_type operator_label_destroy ( chunk const ch ) {
+  if ( 1 == ( ( operator_label_state ) ( ch -> state ) ) -> copies_count -- ) {
+    OPERATOR_CHUNK_RELEASE ( label , ch ) ;
+  }
+  return basic_type_void ;
+}
+
+
+static chunk operator_label_copy ( chunk const ch ) {
+  ( ( operator_label_state ) ( ch -> state ) ) -> copies_count ++ ;
+  return ch ;
+}
+
+
+/*!
+ * Borrowed value of a label (\c NULL if undefined).
+ * The slot is resolved (and cached) only if the dictionary or its version stamp changed since last time.
  */
-chunk operator_label_create ( sstring ss )  { return NULL ; }
+static chunk operator_label_lookup ( chunk const ch ,
+				     interpretation_context ic ) {
+  operator_label_state const st = ( operator_label_state ) ( ch -> state ) ;
+  unsigned long long int const version = dictionary_get_version ( ic -> dic ) ;
+  if ( ( ic -> dic != st -> cached_dic ) || ( version != st -> cached_version ) ) {
+    st -> cached_slot = dictionary_get_slot ( ic -> dic , st -> sy ) ;
+    st -> cached_dic = ic -> dic ;
+    st -> cached_version = version ;
+  }
+  return ( NULL == st -> cached_slot ) ? NULL : dictionary_slot_get_borrowed ( st -> cached_slot ) ;
+}
 
 
 /*!
- * Test whether a chunk is an operator_label
- *
- * \param ch cunk to test
- * \return true iff it is an operator_label
+ * The value is borrowed from the dictionary and held while executed (so that it survives any redefinition during its own execution).
+ * If it is a \c value_block, its \c chunk's are interpreted in order without copying the block, otherwise a copy is interpreted (i.e. stacked).
  */
-bool operator_is_label ( chunk const ch )  { return NULL ; }
+static basic_type operator_label_evaluate ( chunk const ch ,
+					    interpretation_context ic ) {
+  operator_label_state const st = ( operator_label_state ) ( ch -> state ) ;
+  chunk const val = operator_label_lookup ( ch , ic ) ;
+  if ( NULL == val ) {
+    return operator_error ( ic , VALUE_ERROR_UNDEFINED_LABEL ) ;
+  }
+  if ( ic -> do_trace ) {
+    fputs ( "DECLANCHEMENT DE " , stdout ) ;
+    sstring_print ( symbol_get_name ( st -> sy ) , stdout ) ;
+    putchar ( '\n' ) ;
+  }
+  if ( value_is_block ( val ) ) {
+    dictionary_hold ( ic -> dic , st -> sy ) ;
+    interprete_block_borrowed ( val , ic ) ;
+    dictionary_release ( ic -> dic ) ;
+  } else {
+    interprete_chunk ( chunk_copy ( val ) , ic ) ;
+  }
+  return basic_type_void ;
+}
+
+
+static const message_action operator_label_reactions [] = {
+  MESSAGE_ACTION__BASIC_OPERATOR ,
+  { NULL, NULL }
+} ;
+
+
+static const chunk_vtable operator_label_vtable = {
+  CHUNK_VTABLE__BASIC_OPERATOR( label )
+} ;
+
+
+chunk operator_label_create_symbol ( symbol sy ) {
+  chunk ch = OPERATOR_CHUNK_ALLOCATE ( label ) ;
+  operator_label_state const st = ( operator_label_state ) ( ch -> state ) ;
+  st -> copies_count = 1 ;
+  st -> sy = sy ;
+  st -> cached_dic = NULL ;
+  st -> cached_version = 0 ;
+  st -> cached_slot = NULL ;
+  return ch ;
+}
+
+
+chunk operator_label_create ( sstring ss ) {
+  assert ( NULL != ss ) ;
+  assert ( ! sstring_is_empty ( ss ) ) ;
+  chunk const ch = operator_label_create_symbol ( symbol_intern ( ss ) ) ;
+  sstring_destroy ( ss ) ;
+  return ch ;
+}
+
+
+bool operator_is_label ( chunk const ch ) {
+  assert ( NULL != ch ) ;
+  return operator_label_reactions == chunk_header ( ch ) -> reactions ;
+}
+
+
+symbol operator_label_get_symbol ( chunk const ch ) {
+  assert ( operator_is_label ( ch ) ) ;
+  return ( ( operator_label_state ) ( ch -> state ) ) -> sy ;
+}
 
 
+chunk operator_label_get_borrowed ( chunk const ch ,
+				    interpretation_context ic ) {
+  assert ( operator_is_label ( ch ) ) ;
+  assert ( NULL != ic ) ;
+  return operator_label_lookup ( ch , ic ) ;
+}
@@ -3,6 +3,7 @@
 
 # include "operator.h"
 # include "macro_operator.h"
+# include "symbol.h"
 
 
 /*!
@@ -12,6 +13,9 @@
  * If the associated \c value is a \c value_block, then the \c chunk's are processed in order.
  * Otherwise, it is processed as usually.
  *
+ * Names are interned as \c symbol's on creation (i.e. at parse time).
+ * Each label caches its slot in the \c dictionary, which is reused as long as the version stamp of the \c dictionary is unchanged.
+ *
  * Label can be created even if the entry is not defined in the dictionary.
  * It should be defined when evaluated.
  * 
@@ -27,13 +31,22 @@
 /*!
  * Create an \c operator_label.
  *
- * \param ss non empty string
+ * \param ss non empty string (it belongs to the label from now on: it is interned as a \c symbol and destroyed)
  * \pre \c ss in not \ NULL and non-empty (assert-ed)
  * \return a newly created \c operator_label
  */
 extern chunk operator_label_create ( sstring ss ) ;
 
 
+/*!
+ * Create an \c operator_label from an interned name.
+ *
+ * \param sy symbol of the label
+ * \return a newly created \c operator_label
+ */
+extern chunk operator_label_create_symbol ( symbol sy ) ;
+
+
 /*!
  * Test whether a chunk is an operator_label
  *
@@ -43,4 +56,27 @@ extern chunk operator_label_create ( sstring ss ) ;
 extern bool operator_is_label ( chunk const ch ) ;
 
 
+/*!
+ * Symbol of an \c operator_label.
+ *
+ * \param ch \c operator_label to query
+ * \pre \c ch is an \c operator_label (assert-ed)
+ * \return the symbol of the label
+ */
+extern symbol operator_label_get_symbol ( chunk const ch ) ;
+
+
+/*!
+ * Value currently associated to an \c operator_label in the \c dictionary of a context (through the cached slot).
+ * It is \b borrowed: it is only valid until the \c dictionary is modified.
+ *
+ * \param ch \c operator_label to query
+ * \param ic context whose \c dictionary is searched
+ * \pre \c ch is an \c operator_label and \c ic is not \c NULL (assert-ed)
+ * \return the value of the label or \c NULL if it is undefined
+ */
+extern chunk operator_label_get_borrowed ( chunk const ch ,
+					   interpretation_context ic ) ;
+
+
 # endif
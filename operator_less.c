@@ -33,6 +33,4 @@
  */
 
 
-OPERATOR_DECLARE ( less ) 
-
-
+OPERATOR_COMPARATOR( less , < )
@@ -33,6 +33,4 @@
  */
 
 
-OPERATOR_DECLARE ( less_equal ) 
-
-
+OPERATOR_COMPARATOR( less_equal , <= )
@@ -34,6 +34,4 @@
  */
 
 
-OPERATOR_DECLARE ( multiplication ) 
-
-
+OPERATOR_NUMBER( multiplication , * )
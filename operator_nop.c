@@ -26,6 +26,10 @@
  */
 
 
-OPERATOR_DECLARE ( nop ) 
+static basic_type operator_nop_evaluate ( chunk const ch ,
+					  interpretation_context ic ) {
+  return basic_type_void ;
+}
 
 
+OPERATOR_BASIC_FULL( nop , nop )
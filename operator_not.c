@@ -30,6 +30,18 @@
  */
 
 
-OPERATOR_DECLARE ( not ) 
-
-
+static basic_type operator_not_evaluate ( chunk const ch ,
+					  interpretation_context ic ) {
+  chunk const top = chunk_stack_peek ( ic -> stack ) ;
+  if ( NULL == top ) {
+    return operator_error ( ic , VALUE_ERROR_EMPTY_STACK ) ;
+  }
+  if ( ! value_is_boolean ( top ) ) {
+    return operator_error ( ic , VALUE_ERROR_ILLEGAL_OPERAND ) ;
+  }
+  return operator_replace_top ( ic , 1 ,
+				value_boolean_create ( ! basic_type_get_boolean ( value_get_value ( top ) ) ) ) ;
+}
+
+
+OPERATOR_BASIC_FULL( not , ! )
@@ -30,6 +30,4 @@
  */
 
 
-OPERATOR_DECLARE ( or ) 
-
-
+OPERATOR_BOOLEAN( or , || )
@@ -31,6 +31,15 @@
  */
 
 
-OPERATOR_DECLARE ( pop ) 
-
-
+static basic_type operator_pop_evaluate ( chunk const ch ,
+					  interpretation_context ic ) {
+  chunk const top = chunk_stack_pop ( ic -> stack ) ;
+  if ( NULL == top ) {
+    return operator_error ( ic , VALUE_ERROR_EMPTY_STACK ) ;
+  }
+  chunk_destroy ( top ) ;
+  return basic_type_void ;
+}
+
+
+OPERATOR_BASIC_FULL( pop , pop )
@@ -30,6 +30,17 @@
  */
 
 
-OPERATOR_DECLARE ( print ) 
-
-
+static basic_type operator_print_evaluate ( chunk const ch ,
+					    interpretation_context ic ) {
+  chunk const top = chunk_stack_pop ( ic -> stack ) ;
+  if ( NULL == top ) {
+    return operator_error ( ic , VALUE_ERROR_EMPTY_STACK ) ;
+  }
+  chunk_print ( top , stdout ) ;
+  putchar ( '\n' ) ;
+  chunk_destroy ( top ) ;
+  return basic_type_void ;
+}
+
+
+OPERATOR_BASIC_FULL( print , print )
@@ -34,6 +34,13 @@ pop
  */
 
 
-OPERATOR_DECLARE ( print_dictionary ) 
+static basic_type operator_print_dictionary_evaluate ( chunk const ch ,
+						      interpretation_context ic ) {
+  puts ( "vvvvvvvv dictionary vvvvvvvvvv" ) ;
+  dictionary_print ( ic -> dic , stdout ) ;
+  puts ( "^^^^^^^^ dictionary ^^^^^^^^^" ) ;
+  return basic_type_void ;
+}
 
 
+OPERATOR_BASIC_FULL( print_dictionary , print_dictionary )
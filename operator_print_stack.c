@@ -37,6 +37,11 @@ true
  */
 
 
-OPERATOR_DECLARE ( print_stack ) 
+static basic_type operator_print_stack_evaluate ( chunk const ch ,
+						 interpretation_context ic ) {
+  interprete_print_stack ( ic , stdout ) ;
+  return basic_type_void ;
+}
 
 
+OPERATOR_BASIC_FULL( print_stack , print_stack )
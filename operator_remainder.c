@@ -2,7 +2,7 @@
 # include <stdio.h>
 # include <assert.h>
 
-# include "operator_addition.h"
+# include "operator_remainder.h"
 # include "macro_operator_c.h"
 
 # include "value_int.h"
@@ -33,6 +33,4 @@
  */
 
 
-OPERATOR_DECLARE ( remainder ) 
-
-
+OPERATOR_INTEGER( remainder , % )
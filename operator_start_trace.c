@@ -24,6 +24,14 @@
  * \copyright GNU Public License.
  */
 
-OPERATOR_DECLARE ( start_trace ) 
+static basic_type operator_start_trace_evaluate ( chunk const ch ,
+						 interpretation_context ic ) {
+  puts ( ic -> do_trace
+	 ? "==**== keep tracing ==**=="
+	 : "==**== start tracing ==**==" ) ;
+  ic -> do_trace = true ;
+  return basic_type_void ;
+}
 
 
+OPERATOR_BASIC_FULL( start_trace , start_trace )
@@ -26,6 +26,14 @@
  * \copyright GNU Public License.
  */
 
-OPERATOR_DECLARE ( stop_trace ) 
+static basic_type operator_stop_trace_evaluate ( chunk const ch ,
+						interpretation_context ic ) {
+  if ( ic -> do_trace ) {
+    puts ( "==**== stop tracing ==**==" ) ;
+  }
+  ic -> do_trace = false ;
+  return basic_type_void ;
+}
 
 
+OPERATOR_BASIC_FULL( stop_trace , stop_trace )
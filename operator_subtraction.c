@@ -34,7 +34,4 @@
  */
 
 
-OPERATOR_DECLARE ( subtraction ) 
-
-
-
+OPERATOR_NUMBER( subtraction , - )
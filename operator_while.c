@@ -46,6 +46,42 @@
  */
 
 
-OPERATOR_DECLARE ( while ) 
+static basic_type operator_while_evaluate ( chunk const ch ,
+					    interpretation_context ic ) {
+  chunk const cond = chunk_stack_nth ( ic -> stack , 0 ) ;
+  chunk const body = chunk_stack_nth ( ic -> stack , 1 ) ;
+  if ( NULL == body ) {
+    return operator_error ( ic , VALUE_ERROR_EMPTY_STACK ) ;
+  }
+  if ( ! ( ( value_is_block ( cond ) || value_is_protected_label ( cond ) )
+	   && ( value_is_block ( body ) || value_is_protected_label ( body ) ) ) ) {
+    return operator_error ( ic , VALUE_ERROR_ILLEGAL_OPERAND ) ;
+  }
+  chunk_stack_pop ( ic -> stack ) ;
+  chunk_stack_pop ( ic -> stack ) ;
+  basic_type res = basic_type_void ;
+  while ( true ) {
+    interprete_value_borrowed ( cond , ic ) ;
+    chunk const test = chunk_stack_peek ( ic -> stack ) ;
+    if ( NULL == test ) {
+      res = operator_error ( ic , VALUE_ERROR_EMPTY_STACK ) ;
+      break ;
+    }
+    if ( ! value_is_boolean ( test ) ) {
+      res = operator_error ( ic , VALUE_ERROR_ILLEGAL_OPERAND ) ;
+      break ;
+    }
+    bool const b = basic_type_get_boolean ( value_get_value ( test ) ) ;
+    chunk_destroy ( chunk_stack_pop ( ic -> stack ) ) ;
+    if ( ! b ) {
+      break ;
+    }
+    interprete_value_borrowed ( body , ic ) ;
+  }
+  chunk_destroy ( cond ) ;
+  chunk_destroy ( body ) ;
+  return res ;
+}
 
 
+OPERATOR_BASIC_FULL( while , while )
@@ -1,9 +1,11 @@
 # include <stdlib.h>
 # include <stdio.h>
 # include <stdbool.h>
+# include <string.h>
 # include <assert.h>
 
 # include "interpreter.h"
+# include "bytecode.h"
 
 # undef NDEBUG   // FORCE ASSERT ACTIVATION
 
@@ -16,6 +18,10 @@
  * Arguments:
  * \li \c -h help message (and exit)
  * \li \c -t to trace (can be turned off by operator \c stop_trace)
+ * \li \c -w to use the tree-walking interpreter instead of the bytecode virtual machine (to cross-check outputs)
+ * \li \c -f to report the foldings and superinstruction fusions of the bytecode compiler as they are compiled (static sites), and how many times each superinstruction applied at the end (on \c stderr)
+ * \li \c -p to profile the \c operator's and labels (the profile is printed on \c stderr at the end, the program is tree-walked)
+ * \li \c -g \c file.folded to write the time spent in each call chain of labels, \c if, \c if_else and \c while as folded stacks for \c flamegraph.pl (the program is tree-walked)
  * \li \c file.pf file to interprete (otherwise it is stdin)
  *
  * \author Jérôme DURAND-LOSE
@@ -32,6 +38,10 @@ static void help_message ( char const * const prog_name ) {
   printf ( " %s [OPTIONS] [FILE]\n\tRun the pf interpreter on [FILE] (standard input if void)\n" , prog_name ) ;
   puts ( "OPTIONS:" ) ;
   puts ( " -t to trace the execution" ) ;
+  puts ( " -w to walk the chunks instead of running the bytecode" ) ;
+  puts ( " -f to report the foldings and fusions when compiled, and how many times each superinstruction applied (on standard error)" ) ;
+  puts ( " -p to profile the operators and labels (on standard error)" ) ;
+  puts ( " -g FOLDED to write the time of each call chain as folded stacks to FOLDED (for flamegraph.pl)" ) ;
   exit ( 0 ) ;
 }
 
@@ -41,6 +51,53 @@ static void help_message ( char const * const prog_name ) {
  */
 int main ( int const argc ,
 	   char const * const argv [] ) {
-  help_message ( argv [ 0 ] ) ;
-  return 0 ; 	      
+  bool do_trace = false ;
+  bool use_bytecode = true ;
+  bool do_profile = false ;
+  bool do_report_fusions = false ;
+  char const * folded_name = NULL ;
+  char const * file_name = NULL ;
+  for ( int i = 1 ; i < argc ; i ++ ) {
+    if ( 0 == strcmp ( "-h" , argv [ i ] ) ) {
+      help_message ( argv [ 0 ] ) ;
+    } else if ( 0 == strcmp ( "-t" , argv [ i ] ) ) {
+      do_trace = true ;
+    } else if ( 0 == strcmp ( "-w" , argv [ i ] ) ) {
+      use_bytecode = false ;
+    } else if ( 0 == strcmp ( "-f" , argv [ i ] ) ) {
+      bytecode_trace_fusions ( stderr ) ;
+      do_report_fusions = true ;
+    } else if ( 0 == strcmp ( "-p" , argv [ i ] ) ) {
+      do_profile = true ;
+    } else if ( 0 == strcmp ( "-g" , argv [ i ] ) ) {
+      if ( argc <= i + 1 ) {
+	fprintf ( stderr , "%s: -g needs a file name (see %s -h)\n" , argv [ 0 ] , argv [ 0 ] ) ;
+	return 1 ;
+      }
+      folded_name = argv [ ++ i ] ;
+    } else {
+      file_name = argv [ i ] ;
+    }
+  }
+  FILE * const f = ( NULL == file_name ) ? stdin : fopen ( file_name , "r" ) ;
+  if ( NULL == f ) {
+    fprintf ( stderr , "%s: cannot open %s\n" , argv [ 0 ] , file_name ) ;
+    return 1 ;
+  }
+  FILE * const folded = ( NULL == folded_name ) ? NULL : fopen ( folded_name , "w" ) ;
+  if ( ( NULL != folded_name ) && ( NULL == folded ) ) {
+    fprintf ( stderr , "%s: cannot open %s\n" , argv [ 0 ] , folded_name ) ;
+    return 1 ;
+  }
+  interprete ( f , do_trace , use_bytecode , do_profile , folded ) ;
+  if ( do_report_fusions ) {
+    bytecode_print_fusion_counts ( stderr ) ;
+  }
+  if ( stdin != f ) {
+    fclose ( f ) ;
+  }
+  if ( NULL != folded ) {
+    fclose ( folded ) ;
+  }
+  return 0 ;
 }
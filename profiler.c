@@ -0,0 +1,438 @@
+# define _POSIX_C_SOURCE 200809L   // clock_gettime
+
+# include <stdlib.h>
+# include <stdbool.h>
+# include <stdint.h>
+# include <limits.h>
+# include <time.h>
+# include <assert.h>
+
+# include "operator_label.h"
+# include "operator_if.h"
+# include "operator_if_else.h"
+# include "operator_while.h"
+# include "symbol.h"
+
+# include "profiler.h"
+
+
+# undef NDEBUG   // FORCE ASSERT ACTIVATION
+
+
+
+/*!
+ * \file
+ * \brief Execution profile of the \c operator's (options \c -p and \c -g of \c pf).
+ *
+ * Each evaluation of an \c operator is counted and timed (wall-clock, \c CLOCK_MONOTONIC) between \link profiler_enter() \endlink and \link profiler_leave() \endlink.
+ * The \c operator's are gathered by kind (\c +, \c if, \c while…) except for the \c operator_label's that are gathered by label.
+ *
+ * The records are kept in a growing array.
+ * The one of a label is found directly from its symbol, the one of any other kind by scanning the (few) records of kinds.
+ * The evaluations going on are kept on a stack, so that the time spent inside an evaluation can be removed from its \c self time.
+ *
+ * The call tree is kept as nodes linked to their parent, first child and next sibling (the children of a node are few, they are scanned).
+ * The node of the evaluation going on is the current one, its \c self time is increased each time an evaluation ends.
+ *
+ * assert is enforced.
+ *
+ * \author Jérôme DURAND-LOSE
+ * \version 1
+ * \date 2015
+ * \copyright GNU Public License.
+ */
+
+
+/*! Initial capacity of the arrays. */
+# define PROFILER_CAPACITY 32
+
+/*! Index of the root of the call tree (the program itself). */
+# define PROFILER_ROOT 0
+
+/*! Index of no node. */
+# define PROFILER_NO_NODE UINT_MAX
+
+/*! Maximal length of a printed call chain (longer chains are counted for their prefix). */
+# define PROFILER_FOLDED_DEPTH 1024
+
+
+/*!
+ * Record of a kind of \c operator (or of a label).
+ *
+ * \param op copy of the first \c operator of the kind (to print it)
+ * \param is_label whether it is the record of a label
+ * \param is_frame whether its evaluations are part of the call chain (label, \c if, \c if_else and \c while)
+ * \param calls number of evaluations
+ * \param total_ns time of the outermost evaluations
+ * \param self_ns time of the evaluations without the evaluations inside
+ * \param depth number of evaluations going on
+ */
+typedef struct {
+  chunk op ;
+  bool is_label ;
+  bool is_frame ;
+  unsigned long long int calls ;
+  uint64_t total_ns ;
+  uint64_t self_ns ;
+  unsigned int depth ;
+} profiler_record ;
+
+
+/*!
+ * Evaluation going on.
+ *
+ * \param record index of the record of the \c operator
+ * \param start_ns time at which it started
+ * \param inside_ns time of the evaluations done inside (up to now)
+ * \param caller node that was current when it started
+ */
+typedef struct {
+  unsigned int record ;
+  uint64_t start_ns ;
+  uint64_t inside_ns ;
+  unsigned int caller ;
+} profiler_evaluation ;
+
+
+/*!
+ * Node of the call tree: a call chain of labels, \c if, \c if_else and \c while.
+ *
+ * \param record index of the record of the last \c operator of the chain (meaningless for the root)
+ * \param parent index of the node of the chain without the last \c operator
+ * \param first_child index of the first node whose parent it is (\link PROFILER_NO_NODE \endlink if none)
+ * \param next_sibling index of the next node with the same parent (\link PROFILER_NO_NODE \endlink if none)
+ * \param self_ns time spent in the chain, excluding the longer chains
+ */
+typedef struct {
+  unsigned int record ;
+  unsigned int parent ;
+  unsigned int first_child ;
+  unsigned int next_sibling ;
+  uint64_t self_ns ;
+} profiler_node ;
+
+
+/*!
+ * \param start_ns time of creation
+ * \param records_size number of records
+ * \param records_capacity size of \c records
+ * \param records the records
+ * \param labels_size size of \c labels
+ * \param labels for each symbol, 1 + index of its record, or 0 if there is none
+ * \param evaluations_size number of evaluations going on
+ * \param evaluations_capacity size of \c evaluations
+ * \param evaluations the evaluations going on (the last one is the innermost)
+ * \param nodes_size number of nodes
+ * \param nodes_capacity size of \c nodes
+ * \param nodes the nodes of the call tree (the first one is the root)
+ * \param current index of the node of the call chain going on
+ */
+struct profiler_struct {
+  uint64_t start_ns ;
+  unsigned int records_size ;
+  unsigned int records_capacity ;
+  profiler_record * records ;
+  unsigned int labels_size ;
+  unsigned int * labels ;
+  unsigned int evaluations_size ;
+  unsigned int evaluations_capacity ;
+  profiler_evaluation * evaluations ;
+  unsigned int nodes_size ;
+  unsigned int nodes_capacity ;
+  profiler_node * nodes ;
+  unsigned int current ;
+} ;
+
+
+/*!
+ * Current wall-clock time in nanoseconds.
+ */
+static uint64_t profiler_now ( void ) {
+  struct timespec ts ;
+  clock_gettime ( CLOCK_MONOTONIC , & ts ) ;
+  return ( uint64_t ) ts . tv_sec * UINT64_C ( 1000000000 ) + ( uint64_t ) ts . tv_nsec ;
+}
+
+
+profiler profiler_create ( void ) {
+  profiler pr = ( profiler ) malloc ( sizeof ( struct profiler_struct ) ) ;
+  assert ( NULL != pr ) ;
+  pr -> records_size = 0 ;
+  pr -> records_capacity = PROFILER_CAPACITY ;
+  pr -> records = ( profiler_record * ) malloc ( pr -> records_capacity * sizeof ( profiler_record ) ) ;
+  assert ( NULL != pr -> records ) ;
+  pr -> labels_size = 0 ;
+  pr -> labels = NULL ;
+  pr -> evaluations_size = 0 ;
+  pr -> evaluations_capacity = PROFILER_CAPACITY ;
+  pr -> evaluations = ( profiler_evaluation * ) malloc ( pr -> evaluations_capacity * sizeof ( profiler_evaluation ) ) ;
+  assert ( NULL != pr -> evaluations ) ;
+  pr -> nodes_size = 1 ;
+  pr -> nodes_capacity = PROFILER_CAPACITY ;
+  pr -> nodes = ( profiler_node * ) malloc ( pr -> nodes_capacity * sizeof ( profiler_node ) ) ;
+  assert ( NULL != pr -> nodes ) ;
+  pr -> nodes [ PROFILER_ROOT ] = ( profiler_node ) {
+    .record = 0 ,
+    .parent = PROFILER_NO_NODE ,
+    .first_child = PROFILER_NO_NODE ,
+    .next_sibling = PROFILER_NO_NODE ,
+    .self_ns = 0 } ;
+  pr -> current = PROFILER_ROOT ;
+  pr -> start_ns = profiler_now () ;
+  return pr ;
+}
+
+
+void profiler_destroy ( profiler pr ) {
+  assert ( NULL != pr ) ;
+  for ( unsigned int i = 0 ; i < pr -> records_size ; i ++ ) {
+    chunk_destroy ( pr -> records [ i ] . op ) ;
+  }
+  free ( pr -> records ) ;
+  free ( pr -> labels ) ;
+  free ( pr -> evaluations ) ;
+  free ( pr -> nodes ) ;
+  free ( pr ) ;
+}
+
+
+/*!
+ * Add a record for (the kind of) an \c operator.
+ *
+ * \return the index of the record
+ */
+static unsigned int profiler_add_record ( profiler const pr ,
+					  chunk const op ,
+					  bool const is_label ) {
+  if ( pr -> records_size == pr -> records_capacity ) {
+    pr -> records_capacity *= 2 ;
+    pr -> records = ( profiler_record * ) realloc ( pr -> records , pr -> records_capacity * sizeof ( profiler_record ) ) ;
+    assert ( NULL != pr -> records ) ;
+  }
+  pr -> records [ pr -> records_size ] = ( profiler_record ) {
+    .op = chunk_copy ( op ) ,
+    .is_label = is_label ,
+    .is_frame = is_label || operator_is_if ( op ) || operator_is_if_else ( op ) || operator_is_while ( op ) ,
+    .calls = 0 ,
+    .total_ns = 0 ,
+    .self_ns = 0 ,
+    .depth = 0 } ;
+  return pr -> records_size ++ ;
+}
+
+
+/*!
+ * Find (or add) the record of an \c operator.
+ *
+ * \return the index of the record
+ */
+static unsigned int profiler_get_record ( profiler const pr ,
+					  chunk const op ) {
+  if ( operator_is_label ( op ) ) {
+    symbol const sy = operator_label_get_symbol ( op ) ;
+    if ( pr -> labels_size <= sy ) {
+      unsigned int const size = symbol_number () ;
+      assert ( sy < size ) ;
+      pr -> labels = ( unsigned int * ) realloc ( pr -> labels , size * sizeof ( unsigned int ) ) ;
+      assert ( NULL != pr -> labels ) ;
+      for ( unsigned int i = pr -> labels_size ; i < size ; i ++ ) {
+	pr -> labels [ i ] = 0 ;
+      }
+      pr -> labels_size = size ;
+    }
+    if ( 0 == pr -> labels [ sy ] ) {
+      pr -> labels [ sy ] = 1 + profiler_add_record ( pr , op , true ) ;
+    }
+    return pr -> labels [ sy ] - 1 ;
+  }
+  chunk_vtable const * const vtable = chunk_header ( op ) -> vtable ;
+  for ( unsigned int i = 0 ; i < pr -> records_size ; i ++ ) {
+    if ( ( ! pr -> records [ i ] . is_label )
+	 && ( vtable == chunk_header ( pr -> records [ i ] . op ) -> vtable ) ) {
+      return i ;
+    }
+  }
+  return profiler_add_record ( pr , op , false ) ;
+}
+
+
+/*!
+ * Find (or add) the child of a node for a record.
+ *
+ * \return the index of the child
+ */
+static unsigned int profiler_get_child ( profiler const pr ,
+					 unsigned int const node ,
+					 unsigned int const record ) {
+  for ( unsigned int i = pr -> nodes [ node ] . first_child ;
+	PROFILER_NO_NODE != i ;
+	i = pr -> nodes [ i ] . next_sibling ) {
+    if ( record == pr -> nodes [ i ] . record ) {
+      return i ;
+    }
+  }
+  if ( pr -> nodes_size == pr -> nodes_capacity ) {
+    pr -> nodes_capacity *= 2 ;
+    pr -> nodes = ( profiler_node * ) realloc ( pr -> nodes , pr -> nodes_capacity * sizeof ( profiler_node ) ) ;
+    assert ( NULL != pr -> nodes ) ;
+  }
+  pr -> nodes [ pr -> nodes_size ] = ( profiler_node ) {
+    .record = record ,
+    .parent = node ,
+    .first_child = PROFILER_NO_NODE ,
+    .next_sibling = pr -> nodes [ node ] . first_child ,
+    .self_ns = 0 } ;
+  pr -> nodes [ node ] . first_child = pr -> nodes_size ;
+  return pr -> nodes_size ++ ;
+}
+
+
+void profiler_enter ( profiler pr ,
+		      chunk op ) {
+  assert ( NULL != pr ) ;
+  assert ( NULL != op ) ;
+  unsigned int const record = profiler_get_record ( pr , op ) ;
+  pr -> records [ record ] . calls ++ ;
+  pr -> records [ record ] . depth ++ ;
+  if ( pr -> evaluations_size == pr -> evaluations_capacity ) {
+    pr -> evaluations_capacity *= 2 ;
+    pr -> evaluations = ( profiler_evaluation * ) realloc ( pr -> evaluations , pr -> evaluations_capacity * sizeof ( profiler_evaluation ) ) ;
+    assert ( NULL != pr -> evaluations ) ;
+  }
+  unsigned int const caller = pr -> current ;
+  if ( pr -> records [ record ] . is_frame ) {
+    pr -> current = profiler_get_child ( pr , caller , record ) ;
+  }
+  pr -> evaluations [ pr -> evaluations_size ++ ] = ( profiler_evaluation ) {
+    .record = record ,
+    .start_ns = profiler_now () ,
+    .inside_ns = 0 ,
+    .caller = caller } ;
+}
+
+
+void profiler_leave ( profiler pr ) {
+  assert ( NULL != pr ) ;
+  assert ( 0 < pr -> evaluations_size ) ;
+  profiler_evaluation const * const ev = pr -> evaluations + -- pr -> evaluations_size ;
+  uint64_t const elapsed = profiler_now () - ev -> start_ns ;
+  profiler_record * const rec = pr -> records + ev -> record ;
+  rec -> self_ns += elapsed - ev -> inside_ns ;
+  pr -> nodes [ pr -> current ] . self_ns += elapsed - ev -> inside_ns ;
+  pr -> current = ev -> caller ;
+  if ( 0 == -- rec -> depth ) {
+    rec -> total_ns += elapsed ;
+  }
+  if ( 0 < pr -> evaluations_size ) {
+    pr -> evaluations [ pr -> evaluations_size - 1 ] . inside_ns += elapsed ;
+  }
+}
+
+
+/*!
+ * Order of the records for \c qsort: decreasing total time (then decreasing number of calls).
+ */
+static int profiler_compare ( void const * const a ,
+			      void const * const b ) {
+  profiler_record const * const ra = * ( profiler_record const * const * ) a ;
+  profiler_record const * const rb = * ( profiler_record const * const * ) b ;
+  if ( ra -> total_ns != rb -> total_ns ) {
+    return ( ra -> total_ns < rb -> total_ns ) ? 1 : -1 ;
+  }
+  if ( ra -> calls != rb -> calls ) {
+    return ( ra -> calls < rb -> calls ) ? 1 : -1 ;
+  }
+  return 0 ;
+}
+
+
+void profiler_print ( profiler pr ,
+		      FILE * f ) {
+  assert ( NULL != pr ) ;
+  assert ( NULL != f ) ;
+  uint64_t const run_ns = profiler_now () - pr -> start_ns ;
+  profiler_record const ** const sorted = ( profiler_record const ** ) malloc ( ( pr -> records_size + 1 ) * sizeof ( profiler_record const * ) ) ;
+  assert ( NULL != sorted ) ;
+  for ( unsigned int i = 0 ; i < pr -> records_size ; i ++ ) {
+    sorted [ i ] = pr -> records + i ;
+  }
+  qsort ( sorted , pr -> records_size , sizeof ( profiler_record const * ) , profiler_compare ) ;
+  fputs ( "======== profile =================\n" , f ) ;
+  fprintf ( f , "%10s %14s %14s %12s %7s  %s\n" , "calls" , "total ns" , "self ns" , "ns/call" , "% time" , "operator" ) ;
+  for ( unsigned int i = 0 ; i < pr -> records_size ; i ++ ) {
+    profiler_record const * const rec = sorted [ i ] ;
+    fprintf ( f , "%10llu %14llu %14llu %12llu %7.2f  " ,
+	      rec -> calls ,
+	      ( unsigned long long int ) rec -> total_ns ,
+	      ( unsigned long long int ) rec -> self_ns ,
+	      ( unsigned long long int ) ( rec -> total_ns / rec -> calls ) ,
+	      ( 0 < run_ns ) ? 100.0 * rec -> total_ns / run_ns : 0.0 ) ;
+    chunk_print ( rec -> op , f ) ;
+    fputc ( '\n' , f ) ;
+  }
+  fprintf ( f , "======== run time: %llu ns ===\n" , ( unsigned long long int ) run_ns ) ;
+  free ( sorted ) ;
+}
+
+
+/*!
+ * Print the call chain of a node (names separated by \c ';', starting with \c main).
+ * The chain is collected from the node up to the root in \c chain (large enough for \link PROFILER_FOLDED_DEPTH \endlink nodes) and printed backwards.
+ */
+static void profiler_print_chain ( profiler const pr ,
+				   unsigned int node ,
+				   unsigned int * const chain ,
+				   FILE * const f ) {
+  unsigned int length = 0 ;
+  for ( ; PROFILER_ROOT != node ; node = pr -> nodes [ node ] . parent ) {
+    assert ( length < PROFILER_FOLDED_DEPTH ) ;
+    chain [ length ++ ] = node ;
+  }
+  fputs ( "main" , f ) ;
+  while ( 0 < length ) {
+    fputc ( ';' , f ) ;
+    chunk_print ( pr -> records [ pr -> nodes [ chain [ -- length ] ] . record ] . op , f ) ;
+  }
+}
+
+
+void profiler_print_folded ( profiler pr ,
+			     FILE * f ) {
+  assert ( NULL != pr ) ;
+  assert ( NULL != f ) ;
+  uint64_t const run_ns = profiler_now () - pr -> start_ns ;
+  // Depth of each node and node it is counted for (itself or its ancestor at the maximal depth)
+  unsigned int * const depths = ( unsigned int * ) malloc ( pr -> nodes_size * sizeof ( unsigned int ) ) ;
+  unsigned int * const targets = ( unsigned int * ) malloc ( pr -> nodes_size * sizeof ( unsigned int ) ) ;
+  uint64_t * const times = ( uint64_t * ) calloc ( pr -> nodes_size , sizeof ( uint64_t ) ) ;
+  unsigned int * const chain = ( unsigned int * ) malloc ( PROFILER_FOLDED_DEPTH * sizeof ( unsigned int ) ) ;
+  assert ( ( NULL != depths ) && ( NULL != targets ) && ( NULL != times ) && ( NULL != chain ) ) ;
+  uint64_t recorded_ns = 0 ;
+  // A parent is always created before its children
+  for ( unsigned int i = 0 ; i < pr -> nodes_size ; i ++ ) {
+    if ( PROFILER_ROOT == i ) {
+      depths [ i ] = 0 ;
+      targets [ i ] = i ;
+    } else {
+      unsigned int const parent = pr -> nodes [ i ] . parent ;
+      assert ( parent < i ) ;
+      depths [ i ] = depths [ parent ] + 1 ;
+      targets [ i ] = ( depths [ i ] <= PROFILER_FOLDED_DEPTH ) ? i : targets [ parent ] ;
+    }
+    times [ targets [ i ] ] += pr -> nodes [ i ] . self_ns ;
+    recorded_ns += pr -> nodes [ i ] . self_ns ;
+  }
+  if ( recorded_ns < run_ns ) {
+    times [ PROFILER_ROOT ] += run_ns - recorded_ns ;
+  }
+  for ( unsigned int i = 0 ; i < pr -> nodes_size ; i ++ ) {
+    if ( 0 < times [ i ] ) {
+      profiler_print_chain ( pr , i , chain , f ) ;
+      fprintf ( f , " %llu\n" , ( unsigned long long int ) times [ i ] ) ;
+    }
+  }
+  free ( depths ) ;
+  free ( targets ) ;
+  free ( times ) ;
+  free ( chain ) ;
+}
@@ -0,0 +1,121 @@
+# ifndef __PROFILER_H
+# define __PROFILER_H
+
+# include <stdio.h>
+
+# include "chunk.h"
+
+
+/*!
+ * \file
+ * \brief Execution profile of the \c operator's (options \c -p and \c -g of \c pf).
+ *
+ * Each evaluation of an \c operator is counted and timed (wall-clock, \c CLOCK_MONOTONIC) between \link profiler_enter() \endlink and \link profiler_leave() \endlink.
+ * The \c operator's are gathered by kind (\c +, \c if, \c while…) except for the \c operator_label's that are gathered by label.
+ *
+ * For each of them, the following is recorded:
+ * \li \c calls the number of evaluations,
+ * \li \c total the time spent in the evaluations, including the \c operator's evaluated inside (f.e. the body of a label); a recursive evaluation is not counted twice,
+ * \li \c self the time spent in the evaluations, excluding the \c operator's evaluated inside.
+ *
+ * The time per call is \c total divided by \c calls.
+ *
+ * The call chains of labels, \c if, \c if_else and \c while are also recorded as a tree, with the time spent in each chain (excluding the longer chains).
+ * They can be printed as folded stacks for \c flamegraph.pl (see \link profiler_print_folded() \endlink).
+ *
+ * Evaluations are expected to be properly nested (this is the case since they are done by the interpreter).
+ *
+ * The profile is only gathered when a \c profiler is given to the interpreter, otherwise nothing is done at all.
+ *
+ * assert is enforced.
+ *
+ * \author Jérôme DURAND-LOSE
+ * \version 1
+ * \date 2015
+ * \copyright GNU Public License.
+ */
+
+
+/*!
+ * \c profiler is a pointer to a hidden structure.
+ */
+typedef struct profiler_struct * profiler ;
+
+
+/*!
+ * Generate an empty \c profiler.
+ * The run time (used for percentages) starts now.
+ *
+ * \return a new \c profiler
+ */
+extern profiler profiler_create ( void ) ;
+
+
+/*!
+ * Destroy a \c profiler.
+ *
+ * \param pr \c profiler to destroy
+ * \pre \c pr is valid (assert-ed)
+ */
+extern void profiler_destroy ( profiler pr ) ;
+
+
+/*!
+ * Start the evaluation of an \c operator.
+ *
+ * \param pr \c profiler to record to
+ * \param op \c operator about to be evaluated (it is not modified, a copy is kept for the first one of its kind)
+ * \pre \c pr is valid and \c op is not \c NULL (assert-ed)
+ */
+extern void profiler_enter ( profiler pr ,
+			     chunk op ) ;
+
+
+/*!
+ * End the evaluation of the \c operator of the last \link profiler_enter() \endlink not yet ended.
+ *
+ * \param pr \c profiler to record to
+ * \pre \c pr is valid and there is an evaluation going on (assert-ed)
+ */
+extern void profiler_leave ( profiler pr ) ;
+
+
+/*!
+ * Print the profile, sorted by decreasing total time, as follows (the percentage is the one of the run time):
+ * \verbatim
+ ======== profile =================
+      calls       total ns        self ns      ns/call  % time  operator
+        101       52347611         813270       518293   98.74  fact
+       5050         406411         406411           80    0.77  *
+ ======== run time: 53015321 ns ===
+ \endverbatim
+ *
+ * \param pr \c profiler to print
+ * \param f stream to print to
+ * \pre no pointer is \c NULL (assert-ed)
+ */
+extern void profiler_print ( profiler pr ,
+			     FILE * f ) ;
+
+
+/*!
+ * Print the time spent in each call chain as folded stacks (the input format of \c flamegraph.pl), one chain per line, as follows:
+ * \verbatim
+ main 1234
+ main;while;fact 5678
+ main;while;fact;if_else;fact 91011
+ \endverbatim
+ * \c main is the program itself, it is followed by the labels, \c if, \c if_else and \c while evaluated one inside the other.
+ * The number is the time (in nanoseconds) spent in this chain, excluding the longer chains; the time not spent in any \c operator is counted for \c main.
+ * Chains without time are not printed.
+ * Chains are cut after 1024 \c operator's: the time of a longer chain is counted for its first 1024 \c operator's (so that deep recursions give a bounded output).
+ *
+ * \param pr \c profiler to print
+ * \param f stream to print to
+ * \pre no pointer is \c NULL (assert-ed)
+ */
+extern void profiler_print_folded ( profiler pr ,
+				    FILE * f ) ;
+
+
+# endif
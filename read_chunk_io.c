@@ -1,5 +1,7 @@
+# include <stdlib.h>
+# include <stdbool.h>
 # include <string.h>
-# include <ctype.h>
+# include <errno.h>
 # include <assert.h>
 
 # include "read_chunk_io.h"
@@ -39,7 +41,12 @@
 
 /*!
  * \file
- * \brief Read \c chunk from a stream.
+ * \brief Read \c chunk from an \c input_source.
+ *
+ * Labels, keywords, numbers and \c sstring's without escaped \c char's are sliced directly out of the \c input_source (see \link input_source_get_marked() \endlink).
+ *
+ * The tokenizer is table driven: a class table gives the class of each \c char (space, digit, label), a start table gives the kind of \c chunk starting with each \c char and a transition table recognizes the symbolic \c operator's (\c "!" vs \c "!="…).
+ * Runs of spaces, digits and label \c char's are skipped directly in memory by \link input_source_skip_class() \endlink and the bodies of \c sstring's by \link input_source_skip_to() \endlink (\c memchr).
  *
  * \author Jérôme DURAND-LOSE
  * \version 1
@@ -55,13 +62,345 @@
 
 
 /*!
- * Read a token from a stream.
+ * Classes of \c char's (bits of \link read_chunk_io_classes \endlink).
+ */
+enum {
+  READ_CHUNK_IO_SPACE = 1 ,   /*!< \c isspace */
+  READ_CHUNK_IO_DIGIT = 2 ,   /*!< \c isdigit */
+  READ_CHUNK_IO_LABEL = 4 ,   /*!< can be part of a label or keyword (\c isalnum or \c '_') */
+} ;
+
+
+/*!
+ * Class of each \c char (indexed as \c unsigned \c char), in the "C" locale.
+ */
+static unsigned char const read_chunk_io_classes [ 256 ] = {
+  0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 1 , 1 , 1 , 1 , 1 , 0 , 0 ,   // \t \n \v \f \r
+  0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 ,
+  1 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 ,   // ' '
+  6 , 6 , 6 , 6 , 6 , 6 , 6 , 6 , 6 , 6 , 0 , 0 , 0 , 0 , 0 , 0 ,   // 0-9
+  0 , 4 , 4 , 4 , 4 , 4 , 4 , 4 , 4 , 4 , 4 , 4 , 4 , 4 , 4 , 4 ,   // A-O
+  4 , 4 , 4 , 4 , 4 , 4 , 4 , 4 , 4 , 4 , 4 , 0 , 0 , 0 , 0 , 4 ,   // P-Z _
+  0 , 4 , 4 , 4 , 4 , 4 , 4 , 4 , 4 , 4 , 4 , 4 , 4 , 4 , 4 , 4 ,   // a-o
+  4 , 4 , 4 , 4 , 4 , 4 , 4 , 4 , 4 , 4 , 4 , 0 , 0 , 0 , 0 , 0 ,   // p-z
+} ;
+
+
+/*!
+ * Kind of \c chunk starting with a given \c char (entries of \link read_chunk_io_starts \endlink).
+ */
+typedef enum {
+  READ_CHUNK_IO_START_ERROR = 0 ,         /*!< no \c chunk can start with it */
+  READ_CHUNK_IO_START_NUMBER ,            /*!< digit */
+  READ_CHUNK_IO_START_SIGN ,              /*!< sign of a number or symbolic \c operator (\c '+' and \c '-') */
+  READ_CHUNK_IO_START_SYMBOL ,            /*!< other symbolic \c operator */
+  READ_CHUNK_IO_START_SSTRING ,           /*!< \c '"' */
+  READ_CHUNK_IO_START_BLOCK ,             /*!< \c '{' */
+  READ_CHUNK_IO_START_BLOCK_END ,         /*!< \c '}' */
+  READ_CHUNK_IO_START_PROTECTED_LABEL ,   /*!< \c '\\' */
+  READ_CHUNK_IO_START_LABEL ,             /*!< letter or \c '_' */
+} read_chunk_io_start ;
+
+
+/*!
+ * Kind of \c chunk starting with each \c char, filled at first use from the classes and the symbolic \c operator's.
+ */
+static read_chunk_io_start read_chunk_io_starts [ 256 ] ;
+
+
+/*!
+ * Transition on the first \c char of a symbolic \c operator.
+ *
+ * \param single create the one \c char \c operator (\c NULL if there is none)
+ * \param second second \c char of the two \c char's \c operator (\c '\0' if there is none)
+ * \param twofold create the two \c char's \c operator
+ */
+typedef struct {
+  chunk ( * single ) () ;
+  char second ;
+  chunk ( * twofold ) () ;
+} read_chunk_io_symbol_transition ;
+
+
+/*!
+ * Transitions of the symbolic \c operator's, indexed by their first \c char.
+ */
+static read_chunk_io_symbol_transition const read_chunk_io_symbols [ 256 ] = {
+  [ '+' ] = { operator_addition_create , '\0' , NULL } ,
+  [ '-' ] = { operator_subtraction_create , '\0' , NULL } ,
+  [ '*' ] = { operator_multiplication_create , '\0' , NULL } ,
+  [ '/' ] = { operator_division_create , '\0' , NULL } ,
+  [ '%' ] = { operator_remainder_create , '\0' , NULL } ,
+  [ '<' ] = { operator_less_create , '=' , operator_less_equal_create } ,
+  [ '!' ] = { operator_not_create , '=' , operator_different_create } ,
+  [ '=' ] = { NULL , '=' , operator_equal_create } ,
+  [ '&' ] = { NULL , '&' , operator_and_create } ,
+  [ '|' ] = { NULL , '|' , operator_or_create } ,
+} ;
+
+
+/*!
+ * Fill \link read_chunk_io_starts \endlink (only done once).
+ */
+static void read_chunk_io_starts_fill ( void ) {
+  static bool is_filled = false ;
+  if ( is_filled ) {
+    return ;
+  }
+  for ( unsigned int c = 0 ; c < 256 ; c ++ ) {
+    read_chunk_io_starts [ c ] =
+      ( 0 != ( read_chunk_io_classes [ c ] & READ_CHUNK_IO_DIGIT ) ) ? READ_CHUNK_IO_START_NUMBER
+      : ( 0 != ( read_chunk_io_classes [ c ] & READ_CHUNK_IO_LABEL ) ) ? READ_CHUNK_IO_START_LABEL
+      : ( '\0' != read_chunk_io_symbols [ c ] . second ) || ( NULL != read_chunk_io_symbols [ c ] . single ) ? READ_CHUNK_IO_START_SYMBOL
+      : READ_CHUNK_IO_START_ERROR ;
+  }
+  read_chunk_io_starts [ '+' ] = READ_CHUNK_IO_START_SIGN ;
+  read_chunk_io_starts [ '-' ] = READ_CHUNK_IO_START_SIGN ;
+  read_chunk_io_starts [ '"' ] = READ_CHUNK_IO_START_SSTRING ;
+  read_chunk_io_starts [ '{' ] = READ_CHUNK_IO_START_BLOCK ;
+  read_chunk_io_starts [ '}' ] = READ_CHUNK_IO_START_BLOCK_END ;
+  read_chunk_io_starts [ '\\' ] = READ_CHUNK_IO_START_PROTECTED_LABEL ;
+  is_filled = true ;
+}
+
+
+/*!
+ * Whether a \c char (as returned by \link input_source_peek() \endlink) is in some class.
+ */
+static bool read_chunk_io_is ( int const c ,
+			       unsigned char const class ) {
+  return ( EOF != c ) && ( 0 != ( read_chunk_io_classes [ c ] & class ) ) ;
+}
+
+
+static chunk read_chunk_io_any ( input_source is ) ;
+
+
+/*!
+ * Discard spaces.
+ */
+static void read_chunk_io_skip_spaces ( input_source is ) {
+  input_source_skip_class ( is , read_chunk_io_classes , READ_CHUNK_IO_SPACE ) ;
+}
+
+
+/*!
+ * Read a number, the mark is on its first \c char (digit or sign) which is already read.
+ * It is a \c value_double if there is a \c '.', otherwise a \c value_int.
+ * Integers are accumulated directly unless they are too long to be sure not to overflow.
+ * An integer out of the range of \c long \c long \c int is a syntax error (it is not clamped).
+ */
+static chunk read_chunk_io_number ( input_source is ) {
+  input_source_skip_class ( is , read_chunk_io_classes , READ_CHUNK_IO_DIGIT ) ;
+  bool const is_double = '.' == input_source_peek ( is ) ;
+  if ( is_double ) {
+    input_source_get ( is ) ;
+    input_source_skip_class ( is , read_chunk_io_classes , READ_CHUNK_IO_DIGIT ) ;
+  }
+  unsigned int length ;
+  char const * const chars = input_source_get_marked ( is , & length ) ;
+  if ( TOKEN_KEYWORD_MAX_LEGTH < length ) {
+    return value_error_create ( VALUE_ERROR_IO_SYNTAX ) ;
+  }
+  if ( ( ! is_double ) && ( length <= 18 ) ) {
+    bool const is_negative = '-' == chars [ 0 ] ;
+    long long int n = 0 ;
+    for ( unsigned int i = ( '0' <= chars [ 0 ] ) ? 0 : 1 ; i < length ; i ++ ) {
+      n = 10 * n + ( chars [ i ] - '0' ) ;
+    }
+    return value_int_create ( is_negative ? - n : n ) ;
+  }
+  char number [ TOKEN_KEYWORD_MAX_LEGTH + 1 ] ;
+  memcpy ( number , chars , length ) ;
+  number [ length ] = '\0' ;
+  if ( is_double ) {
+    return value_double_create ( BASIC_FLOAT_PARSE ( number , NULL ) ) ;
+  }
+  errno = 0 ;
+  long long int const n = strtoll ( number , NULL , 10 ) ;
+  if ( ERANGE == errno ) {
+    return value_error_create ( VALUE_ERROR_IO_SYNTAX ) ;
+  }
+  return value_int_create ( n ) ;
+}
+
+
+/*!
+ * Read a \c sstring, the opening \c '"' is already read.
+ * The runs of \c char's between escapes are found with \link input_source_skip_to() \endlink and sliced from the \c input_source.
+ */
+static chunk read_chunk_io_sstring ( input_source is ) {
+  input_source_mark ( is ) ;
+  input_source_skip_to ( is , '"' , '\\' ) ;
+  unsigned int length ;
+  char const * chars = input_source_get_marked ( is , & length ) ;
+  sstring ss = sstring_create_chars ( chars , length ) ;
+  int c ;
+  while ( '"' != ( c = input_source_get ( is ) ) ) {
+    if ( '\\' == c ) {
+      switch ( c = input_source_get ( is ) ) {
+      case 'n' :
+	c = '\n' ;
+	break ;
+      case 't' :
+	c = '\t' ;
+	break ;
+      case '"' :
+      case '\\' :
+	break ;
+      default :
+	c = EOF ;
+      }
+    }
+    if ( EOF == c ) {
+      sstring_destroy ( ss ) ;
+      return value_error_create ( VALUE_ERROR_IO_MALFORMED_STRING ) ;
+    }
+    sstring_append_char ( ss , c ) ;
+    input_source_mark ( is ) ;
+    input_source_skip_to ( is , '"' , '\\' ) ;
+    chars = input_source_get_marked ( is , & length ) ;
+    sstring_append_chars ( ss , chars , length ) ;
+  }
+  return value_sstring_create ( ss ) ;
+}
+
+
+/*!
+ * Read a \c value_block, the opening \c '{' is already read.
+ */
+static chunk read_chunk_io_block ( input_source is ) {
+  linked_list_chunk llc = linked_list_chunk_create () ;
+  while ( true ) {
+    read_chunk_io_skip_spaces ( is ) ;
+    int const c = input_source_peek ( is ) ;
+    if ( EOF == c ) {
+      linked_list_chunk_destroy ( llc ) ;
+      return value_error_create ( VALUE_ERROR_IO_UNFINISHED_BLOCK ) ;
+    }
+    if ( '}' == c ) {
+      input_source_get ( is ) ;
+      return value_block_create ( llc ) ;
+    }
+    chunk const ch = read_chunk_io_any ( is ) ;
+    if ( value_is_error ( ch ) ) {
+      linked_list_chunk_destroy ( llc ) ;
+      return ch ;
+    }
+    linked_list_chunk_add_back ( llc , ch ) ;
+  }
+}
+
+
+/*!
+ * Find a keyword in \c operator_creator_list.
+ *
+ * \return the entry of the keyword or \c NULL if it is not a keyword
+ */
+static operator_creator const * read_chunk_io_find_keyword ( char const * const chars ,
+							     unsigned int const length ) {
+  for ( operator_creator const * oc = operator_creator_list ; NULL != oc -> keyword ; oc ++ ) {
+    if ( ( 0 == strncmp ( oc -> keyword , chars , length ) )
+	 && ( '\0' == oc -> keyword [ length ] ) ) {
+      return oc ;
+    }
+  }
+  return NULL ;
+}
+
+
+/*!
+ * Read a label or a keyword (including \c true and \c false), the mark is on its first \c char.
+ *
+ * \param is_protected whether it is preceded by a \c '\\' (already read), then it cannot be a keyword
+ */
+static chunk read_chunk_io_label ( input_source is ,
+				   bool const is_protected ) {
+  input_source_skip_class ( is , read_chunk_io_classes , READ_CHUNK_IO_LABEL ) ;
+  unsigned int length ;
+  char const * const chars = input_source_get_marked ( is , & length ) ;
+  if ( 0 == length ) {
+    return value_error_create ( VALUE_ERROR_IO_LABEL_EMPTY ) ;
+  }
+  if ( TOKEN_KEYWORD_MAX_LEGTH < length ) {
+    return value_error_create ( VALUE_ERROR_IO_SYNTAX ) ;
+  }
+  bool const is_true = ( 4 == length ) && ( 0 == strncmp ( "true" , chars , length ) ) ;
+  bool const is_false = ( 5 == length ) && ( 0 == strncmp ( "false" , chars , length ) ) ;
+  operator_creator const * const oc = read_chunk_io_find_keyword ( chars , length ) ;
+  if ( is_protected ) {
+    return ( is_true || is_false || ( NULL != oc ) )
+      ? value_error_create ( VALUE_ERROR_IO_LABEL_IS_KEYWORD )
+      : value_protected_label_create ( sstring_create_chars ( chars , length ) ) ;
+  }
+  if ( is_true || is_false ) {
+    return value_boolean_create ( is_true ) ;
+  }
+  return ( NULL != oc )
+    ? oc -> create_operator ()
+    : operator_label_create ( sstring_create_chars ( chars , length ) ) ;
+}
+
+
+/*!
+ * Read a symbolic \c operator, its first \c char \c c is already read.
+ * The transition of \c c in \link read_chunk_io_symbols \endlink tells whether the next \c char (peeked) makes a two \c char's \c operator.
+ */
+static chunk read_chunk_io_symbol ( input_source is ,
+				    int const c ) {
+  read_chunk_io_symbol_transition const * const tr = read_chunk_io_symbols + c ;
+  if ( ( '\0' != tr -> second ) && ( tr -> second == input_source_peek ( is ) ) ) {
+    input_source_get ( is ) ;
+    return tr -> twofold () ;
+  }
+  return ( NULL != tr -> single )
+    ? tr -> single ()
+    : value_error_create ( VALUE_ERROR_IO_SYNTAX ) ;
+}
+
+
+/*!
+ * Read any \c chunk, the first \c char is not a space.
+ * The kind of \c chunk is given by \link read_chunk_io_starts \endlink on the first \c char.
+ */
+static chunk read_chunk_io_any ( input_source is ) {
+  input_source_mark ( is ) ;
+  int const c = input_source_get ( is ) ;
+  assert ( EOF != c ) ;
+  switch ( read_chunk_io_starts [ c ] ) {
+  case READ_CHUNK_IO_START_NUMBER :
+    return read_chunk_io_number ( is ) ;
+  case READ_CHUNK_IO_START_SIGN :
+    return read_chunk_io_is ( input_source_peek ( is ) , READ_CHUNK_IO_DIGIT )
+      ? read_chunk_io_number ( is )
+      : read_chunk_io_symbol ( is , c ) ;
+  case READ_CHUNK_IO_START_SYMBOL :
+    return read_chunk_io_symbol ( is , c ) ;
+  case READ_CHUNK_IO_START_SSTRING :
+    return read_chunk_io_sstring ( is ) ;
+  case READ_CHUNK_IO_START_BLOCK :
+    return read_chunk_io_block ( is ) ;
+  case READ_CHUNK_IO_START_PROTECTED_LABEL :
+    input_source_mark ( is ) ;
+    return read_chunk_io_label ( is , true ) ;
+  case READ_CHUNK_IO_START_LABEL :
+    return read_chunk_io_label ( is , false ) ;
+  case READ_CHUNK_IO_START_BLOCK_END :
+  case READ_CHUNK_IO_START_ERROR :
+  default :
+    return value_error_create ( VALUE_ERROR_IO_SYNTAX ) ;
+  }
+}
+
+
+/*!
+ * Read a token from an \c input_source.
  *
  * The first (non-space) character is read and depending on it, only some \c chunk are possible.
  * More characters are read until:
  * \li chunk is fully read, and
  * \li there is no ambiguity  (\c"!" from \c"!=", minus operation from sign of number…).
- * If one (or more) \c char that could belong to another \c chunk are read to settle ambiguity, they are put back (with \c ungetc).
+ * \c char's that could belong to another \c chunk are only peeked to settle ambiguity (see \link input_source_peek() \endlink).
  *
  * Label (protected or not) are distinguished from keywords by using the table in \c operator_creator_list.
  *
@@ -72,13 +411,27 @@
  * If the OEF is reached before anything is read, then a \c value_error with \c VALUE_ERROR_IO_EOF is returned.
  *
  * If the input cannot form a legal \c chunk, then a corresponding  \c value_error is returned.
+ * An integer out of the range of \c long \c long \c int is a \c VALUE_ERROR_IO_SYNTAX (it is not clamped).
  *
- * \param f \c stream to read from
- * \pre \c f is not \c NULL (assert-ed)
+ * \param is \c input_source to read from
+ * \pre \c is is not \c NULL (assert-ed)
  * \return chunk read (should be a \c value or an \c operator) or a \c value_error if reading fail.
  */
-
-chunk read_chunk_io ( FILE * f )  { return NULL ; }
-
-
-
+chunk read_chunk_io ( input_source is ) {
+  assert ( NULL != is ) ;
+  read_chunk_io_starts_fill () ;
+  read_chunk_io_skip_spaces ( is ) ;
+  int const c = input_source_peek ( is ) ;
+  if ( EOF == c ) {
+    return value_error_create ( VALUE_ERROR_IO_EOF ) ;
+  }
+  if ( '}' == c ) {
+    input_source_get ( is ) ;
+    return value_error_create ( VALUE_ERROR_IO_SYNTAX ) ;
+  }
+  chunk const ch = read_chunk_io_any ( is ) ;
+  if ( ! value_is_error ( ch ) ) {
+    read_chunk_io_skip_spaces ( is ) ;
+  }
+  return ch ;
+}
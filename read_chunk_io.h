@@ -4,10 +4,16 @@
 # include <stdio.h>
 
 # include "chunk.h"
+# include "input_source.h"
 
 /*!
  * \file
- * \brief Read \c chunk from a stream.
+ * \brief Read \c chunk from an \c input_source.
+ *
+ * Labels, keywords, numbers and \c sstring's without escaped \c char's are sliced directly out of the \c input_source (see \link input_source_get_marked() \endlink).
+ *
+ * The tokenizer is table driven: a class table gives the class of each \c char (space, digit, label), a start table gives the kind of \c chunk starting with each \c char and a transition table recognizes the symbolic \c operator's (\c "!" vs \c "!="…).
+ * Runs of spaces, digits and label \c char's are skipped directly in memory by \link input_source_skip_class() \endlink and the bodies of \c sstring's by \link input_source_skip_to() \endlink (\c memchr).
  *
  * \author Jérôme DURAND-LOSE
  * \version 1
@@ -23,13 +29,13 @@
 
 
 /*!
- * Read a token from a stream.
+ * Read a token from an \c input_source.
  *
  * The first (non-space) character is read and depending on it, only some \c chunk are possible.
  * More characters are read until:
  * \li chunk is fully read, and
  * \li there is no ambiguity  (\c"!" from \c"!=", minus operation from sign of number…).
- * If one (or more) \c char that could belong to another \c chunk are read to settle ambiguity, they are put back (with \c ungetc).
+ * \c char's that could belong to another \c chunk are only peeked to settle ambiguity (see \link input_source_peek() \endlink).
  *
  * Label (protected or not) are distinguished from keywords by using the table in \c operator_creator_list.
  *
@@ -40,13 +46,14 @@
  * If the OEF is reached before anything is read, then a \c value_error with \c VALUE_ERROR_IO_EOF is returned.
  *
  * If the input cannot form a legal \c chunk, then a corresponding  \c value_error is returned.
+ * An integer out of the range of \c long \c long \c int is a \c VALUE_ERROR_IO_SYNTAX (it is not clamped).
  *
- * \param f \c stream to read from
- * \pre \c f is not \c NULL (assert-ed)
+ * \param is \c input_source to read from
+ * \pre \c is is not \c NULL (assert-ed)
  * \return chunk read (should be a \c value or an \c operator) or a \c value_error if reading fail.
  */
 
-extern chunk read_chunk_io ( FILE * f ) ;
+extern chunk read_chunk_io ( input_source is ) ;
 
 
 # endif
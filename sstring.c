@@ -1,4 +1,5 @@
 # include <stdlib.h>
+# include <stddef.h>
 # include <string.h>
 # include <ctype.h>
 # include <assert.h>
@@ -13,10 +14,19 @@
  * \file
  * \brief This module provides a « safer » string.
  * 
- * These are not C-string but a \c struct that holds the length of the string and a pointer to the actual char sequence.
+ * These are not C-string but a \c struct that holds the length of the string and the actual char sequence.
  * Please note that there is no \c '\0' to mark the end of the \c sstring.
  *
- * Empty string is encoded by 0 \c length and \c NULL \c pointer.
+ * Scans of the \c char sequence (copy, comparison, search) are done through \c memcpy, \c memcmp and \c memchr.
+ * These are vectorized by the C library, which selects the best implementation for the CPU at run time.
+ *
+ * Short strings (up to \c SSTRING_INLINE_CAPACITY \c char's) are stored inline in the \c struct, so that they only need one allocation.
+ * Longer ones are stored in a separately allocated buffer.
+ * The buffer grows geometrically so that appending (\link sstring_concatenate() \endlink, \link sstring_append_char() \endlink) is amortized O(1).
+ *
+ * \c sstring's can be interned with \link sstring_intern() \endlink: there is then a single canonical instance for each \c char sequence.
+ * Interned \c sstring's have their hash precomputed and are compared by address.
+ * They are shared, must not be modified nor destroyed: each \link sstring_intern() \endlink is matched by a \link sstring_unintern() \endlink and the last one releases the instance (the ones still interned are released at exit).
  *
  * assert is enforced.
  *
@@ -29,7 +39,74 @@
  */
 
 
-/*! \c sstring is a pointer to a hidden structure. */
+/*! Maximal length of a \c sstring stored inline. */
+# define SSTRING_INLINE_CAPACITY 24
+
+/*! Initial number of slots of the table of interned \c sstring's (must be a power of 2). */
+# define SSTRING_INTERN_INITIAL_CAPACITY 256
+
+
+/*!
+ * \param hash cached hash of the \c char sequence (meaningful only if \c hash_is_set)
+ * \param length number of \c char's
+ * \param hash_is_set whether \c hash is up to date (it is reset by any modification)
+ * \param intern_count number of references to this canonical instance of its \c char sequence (0 if it is not interned)
+ * \param on_heap whether the \c char sequence is in \c storage.heap (otherwise it is in \c storage.local)
+ * \param storage the \c char sequence: inline or in an allocated buffer of \c capacity \c char's
+ */
+struct sstring_struct {
+  size_t hash ;
+  unsigned int length ;
+  unsigned int intern_count ;
+  bool hash_is_set ;
+  bool on_heap ;
+  union {
+    struct {
+      char * chars ;
+      unsigned int capacity ;
+    } heap ;
+    char local [ SSTRING_INLINE_CAPACITY ] ;
+  } storage ;
+} ;
+
+
+/*!
+ * Where the \c char sequence of a \c sstring is stored.
+ */
+static char * sstring_chars ( sstring const ss ) {
+  return ss -> on_heap
+    ? ss -> storage . heap . chars
+    : ss -> storage . local ;
+}
+
+
+/*!
+ * Ensure that a \c sstring can hold \c length \c char's.
+ *
+ * When the storage is too small, the new buffer is at least twice as large as the previous storage.
+ * Appending is thus amortized O(1) and building a \c sstring piece by piece is linear.
+ */
+static void sstring_reserve ( sstring const ss ,
+			      unsigned int const length ) {
+  unsigned int const capacity = ss -> on_heap
+    ? ss -> storage . heap . capacity
+    : SSTRING_INLINE_CAPACITY ;
+  if ( length <= capacity ) {
+    return ;
+  }
+  unsigned int const new_capacity = ( length < 2 * capacity ) ? 2 * capacity : length ;
+  if ( ss -> on_heap ) {
+    ss -> storage . heap . chars = ( char * ) realloc ( ss -> storage . heap . chars , new_capacity ) ;
+    assert ( NULL != ss -> storage . heap . chars ) ;
+  } else {
+    char * const chars = ( char * ) malloc ( new_capacity ) ;
+    assert ( NULL != chars ) ;
+    memcpy ( chars , ss -> storage . local , ss -> length ) ;
+    ss -> storage . heap . chars = chars ;
+    ss -> on_heap = true ;
+  }
+  ss -> storage . heap . capacity = new_capacity ;
+}
 
 
 /*!
@@ -37,7 +114,15 @@
  *
  * \return an empty \c sstring
  */
-sstring sstring_create_empty ( void )  { return NULL ; }
+sstring sstring_create_empty ( void ) {
+  sstring ss = ( sstring ) malloc ( sizeof ( struct sstring_struct ) ) ;
+  assert ( NULL != ss ) ;
+  ss -> length = 0 ;
+  ss -> hash_is_set = false ;
+  ss -> intern_count = 0 ;
+  ss -> on_heap = false ;
+  return ss ;
+}
 
 
 /*!
@@ -47,7 +132,36 @@ sstring sstring_create_empty ( void )  { return NULL ; }
  * \pre st is not \c NULL (assert-ed)
  * \return a sstring corresponding to st
  */
-sstring sstring_create_string ( char const * const st )  { return NULL ; }
+sstring sstring_create_string ( char const * const st ) {
+  assert ( NULL != st ) ;
+  sstring ss = sstring_create_empty () ;
+  unsigned int const length = strlen ( st ) ;
+  sstring_reserve ( ss , length ) ;
+  memcpy ( sstring_chars ( ss ) , st , length ) ;
+  ss -> length = length ;
+  return ss ;
+}
+
+
+/*!
+ * Generate a \c sstring with the same \c char sequence as an array of \c char's.
+ *
+ * \param chars \c char's to copy (there is no need for a \c '\0')
+ * \param length number of \c char's
+ * \pre chars is not \c NULL unless \c length is 0 (assert-ed)
+ * \return a sstring with the \c length first \c char's of \c chars
+ */
+sstring sstring_create_chars ( char const * const chars ,
+			      unsigned int const length ) {
+  assert ( ( NULL != chars ) || ( 0 == length ) ) ;
+  sstring ss = sstring_create_empty () ;
+  sstring_reserve ( ss , length ) ;
+  if ( 0 < length ) {
+    memcpy ( sstring_chars ( ss ) , chars , length ) ;
+  }
+  ss -> length = length ;
+  return ss ;
+}
 
 
 /*!
@@ -55,8 +169,16 @@ sstring sstring_create_string ( char const * const st )  { return NULL ; }
  *
  * \param ss C-string to destroy
  * \pre ss is a valid \c sstring (assert-ed)
+ * \pre ss is not interned (assert-ed)
  */
-void sstring_destroy ( sstring ss )  {}
+void sstring_destroy ( sstring ss ) {
+  assert ( NULL != ss ) ;
+  assert ( 0 == ss -> intern_count ) ;
+  if ( ss -> on_heap ) {
+    free ( ss -> storage . heap . chars ) ;
+  }
+  free ( ss ) ;
+}
 
 
 /*!
@@ -69,7 +191,13 @@ void sstring_destroy ( sstring ss )  {}
  * \pre f is not \c NULL (assert-ed)
  */
 void sstring_print ( sstring ss ,
-			    FILE * f )  {}
+		     FILE * f ) {
+  assert ( NULL != ss ) ;
+  assert ( NULL != f ) ;
+  if ( 0 < ss -> length ) {
+    fwrite ( sstring_chars ( ss ) , sizeof ( char ) , ss -> length , f ) ;
+  }
+}
 
 /*!
  * Concatenate a \c sstring at the end of another.
@@ -77,9 +205,68 @@ void sstring_print ( sstring ss ,
  * \param ss1 \c sstring to be modified
  * \param ss2 \c sstring to concatenate to \c ss1
  * \pre \c ss1 and \c ss2 are valid \c sstring (assert-ed)
+ * \pre \c ss1 is not interned (assert-ed)
  */
 void sstring_concatenate ( sstring ss1,
-				  sstring ss2 )  {}
+			   sstring ss2 ) {
+  assert ( NULL != ss1 ) ;
+  assert ( NULL != ss2 ) ;
+  assert ( 0 == ss1 -> intern_count ) ;
+  if ( 0 == ss2 -> length ) {
+    return ;
+  }
+  unsigned int const length = ss1 -> length + ss2 -> length ;
+  sstring_reserve ( ss1 , length ) ;
+  // ss2 may be ss1: its chars are read after the reservation and its length before the update
+  memcpy ( sstring_chars ( ss1 ) + ss1 -> length , sstring_chars ( ss2 ) , ss2 -> length ) ;
+  ss1 -> length = length ;
+  ss1 -> hash_is_set = false ;
+}
+
+/*!
+ * Add a \c char at the end of a \c sstring.
+ *
+ * This is amortized O(1) so that a \c sstring can be built \c char by \c char in linear time.
+ *
+ * \param ss \c sstring to be modified
+ * \param c \c char to add
+ * \pre \c ss is a valid \c sstring (assert-ed)
+ * \pre \c ss is not interned (assert-ed)
+ */
+void sstring_append_char ( sstring ss ,
+			   char c ) {
+  assert ( NULL != ss ) ;
+  assert ( 0 == ss -> intern_count ) ;
+  sstring_reserve ( ss , ss -> length + 1 ) ;
+  sstring_chars ( ss ) [ ss -> length ++ ] = c ;
+  ss -> hash_is_set = false ;
+}
+
+/*!
+ * Add \c char's at the end of a \c sstring.
+ *
+ * \param ss \c sstring to be modified
+ * \param chars \c char's to add (there is no need for a \c '\0')
+ * \param length number of \c char's to add
+ * \pre \c ss is a valid \c sstring (assert-ed)
+ * \pre \c ss is not interned (assert-ed)
+ * \pre \c chars is not \c NULL (assert-ed)
+ */
+void sstring_append_chars ( sstring ss ,
+			    char const * const chars ,
+			    unsigned int const length ) {
+  assert ( NULL != ss ) ;
+  assert ( 0 == ss -> intern_count ) ;
+  assert ( NULL != chars ) ;
+  if ( 0 == length ) {
+    return ;
+  }
+  sstring_reserve ( ss , ss -> length + length ) ;
+  memcpy ( sstring_chars ( ss ) + ss -> length , chars , length ) ;
+  ss -> length += length ;
+  ss -> hash_is_set = false ;
+}
+
 
 /*!
  * Provide a copy of a string.
@@ -88,7 +275,14 @@ void sstring_concatenate ( sstring ss1,
  * \pre ss is a valid \c sstring (assert-ed)
  * \return an independant copy of \c ss
  */
-sstring sstring_copy ( sstring ss )  { return NULL ; }
+sstring sstring_copy ( sstring ss ) {
+  assert ( NULL != ss ) ;
+  sstring copy = sstring_create_empty () ;
+  sstring_concatenate ( copy , ss ) ;
+  copy -> hash = ss -> hash ;
+  copy -> hash_is_set = ss -> hash_is_set ;
+  return copy ;
+}
 
 
 /*!
@@ -103,7 +297,23 @@ sstring sstring_copy ( sstring ss )  { return NULL ; }
  * \li 1 otherwise
  */
 int sstring_compare ( sstring ss1 ,
-			     sstring ss2 )  { return 0 ; }
+		      sstring ss2 ) {
+  assert ( NULL != ss1 ) ;
+  assert ( NULL != ss2 ) ;
+  if ( ss1 == ss2 ) {
+    return 0 ;
+  }
+  unsigned int const length = ( ss1 -> length < ss2 -> length ) ? ss1 -> length : ss2 -> length ;
+  int const cmp = ( 0 == length ) ? 0 : memcmp ( sstring_chars ( ss1 ) , sstring_chars ( ss2 ) , length ) ;
+  if ( 0 != cmp ) {
+    return ( cmp < 0 ) ? -1 : 1 ;
+  }
+  return ( ss1 -> length < ss2 -> length )
+    ? -1
+    : ( ( ss1 -> length == ss2 -> length )
+	? 0
+	: 1 ) ;
+}
 
 
 /*!
@@ -115,6 +325,237 @@ int sstring_compare ( sstring ss1 ,
  * \pre ss is a valid \c sstring (assert-ed)
  * \return true ssi \c ss is empty
  */
-bool sstring_is_empty ( sstring ss )  { return NULL ; }
+bool sstring_is_empty ( sstring ss ) {
+  assert ( NULL != ss ) ;
+  return 0 == ss -> length ;
+}
+
+
+/*!
+ * Hash of a \c sstring (FNV-1a over the \c char sequence).
+ *
+ * It is computed once and cached in the \c sstring until it is modified.
+ * Copies inherit the cached hash.
+ *
+ * \param ss \c sstring to hash
+ * \pre ss is a valid \c sstring (assert-ed)
+ * \return the hash of \c ss
+ */
+size_t sstring_hash ( sstring ss ) {
+  assert ( NULL != ss ) ;
+  if ( ! ss -> hash_is_set ) {
+    size_t hash = ( size_t ) 2166136261u ;
+    char const * const chars = sstring_chars ( ss ) ;
+    for ( unsigned int i = 0 ; i < ss -> length ; i ++ ) {
+      hash = ( hash ^ ( unsigned char ) chars [ i ] ) * ( size_t ) 16777619u ;
+    }
+    ss -> hash = hash ;
+    ss -> hash_is_set = true ;
+  }
+  return ss -> hash ;
+}
 
 
+/*!
+ * Indicate whether two \c sstring are equal.
+ *
+ * Two interned \c sstring are only compared by address.
+ * Otherwise, if both hashes are already cached, they are compared first so that different \c sstring are usually told apart without looking at the \c char's.
+ * Hashes are not computed for this purpose: comparing the \c char's (with \c memcmp) is cheaper than hashing them.
+ *
+ * \param ss1 \c sstring 
+ * \param ss2 \c sstring 
+ * \pre ss1 and ss2 are valid \c sstring (assert-ed)
+ * \return true iff \c ss1 and \c ss2 hold the same \c char sequence
+ */
+bool sstring_equal ( sstring ss1 ,
+		     sstring ss2 ) {
+  assert ( NULL != ss1 ) ;
+  assert ( NULL != ss2 ) ;
+  if ( ( 0 < ss1 -> intern_count ) && ( 0 < ss2 -> intern_count ) ) {
+    return ss1 == ss2 ;
+  }
+  if ( ss1 == ss2 ) {
+    return true ;
+  }
+  if ( ss1 -> length != ss2 -> length ) {
+    return false ;
+  }
+  if ( ss1 -> hash_is_set && ss2 -> hash_is_set && ( ss1 -> hash != ss2 -> hash ) ) {
+    return false ;
+  }
+  return ( 0 == ss1 -> length )
+    || ( 0 == memcmp ( sstring_chars ( ss1 ) , sstring_chars ( ss2 ) , ss1 -> length ) ) ;
+}
+
+
+
+/*!
+ * Search for a \c char in a \c sstring.
+ *
+ * \param ss \c sstring to search
+ * \param c \c char to look for
+ * \param from position to start the search from
+ * \pre ss is a valid \c sstring (assert-ed)
+ * \return the position of the first occurrence of \c c at or after \c from, or the length of \c ss if there is none
+ */
+unsigned int sstring_find_char ( sstring ss ,
+				 char c ,
+				 unsigned int from ) {
+  assert ( NULL != ss ) ;
+  if ( ss -> length <= from ) {
+    return ss -> length ;
+  }
+  char const * const chars = sstring_chars ( ss ) ;
+  char const * const found = ( char const * ) memchr ( chars + from , c , ss -> length - from ) ;
+  return ( NULL == found )
+    ? ss -> length
+    : ( unsigned int ) ( found - chars ) ;
+}
+
+/*! Table of interned \c sstring's (open addressing with linear probing), \c NULL for a free slot. */
+static sstring * sstring_intern_slots = NULL ;
+
+/*! Number of slots of the table (a power of 2). */
+static unsigned int sstring_intern_capacity = 0 ;
+
+/*! Number of interned \c sstring's. */
+static unsigned int sstring_intern_size = 0 ;
+
+
+/*!
+ * Release all interned \c sstring's (registered with \c atexit).
+ */
+static void sstring_intern_release ( void ) {
+  for ( unsigned int i = 0 ; i < sstring_intern_capacity ; i ++ ) {
+    if ( NULL != sstring_intern_slots [ i ] ) {
+      sstring_intern_slots [ i ] -> intern_count = 0 ;
+      sstring_destroy ( sstring_intern_slots [ i ] ) ;
+    }
+  }
+  free ( sstring_intern_slots ) ;
+  sstring_intern_slots = NULL ;
+  sstring_intern_capacity = 0 ;
+  sstring_intern_size = 0 ;
+}
+
+
+/*!
+ * Find the slot of a \c char sequence: either the slot holding its interned \c sstring or the free slot where it should be inserted.
+ */
+static sstring * sstring_intern_find_slot ( sstring * const slots ,
+					    unsigned int const capacity ,
+					    sstring const ss ) {
+  unsigned int const mask = capacity - 1 ;
+  unsigned int i = sstring_hash ( ss ) & mask ;
+  while ( ( NULL != slots [ i ] )
+	  && ! sstring_equal ( ss , slots [ i ] ) ) {
+    i = ( i + 1 ) & mask ;
+  }
+  return slots + i ;
+}
+
+
+/*!
+ * Double the table (or allocate it on first use).
+ */
+static void sstring_intern_grow ( void ) {
+  unsigned int const capacity = ( 0 == sstring_intern_capacity )
+    ? SSTRING_INTERN_INITIAL_CAPACITY
+    : 2 * sstring_intern_capacity ;
+  sstring * const slots = ( sstring * ) calloc ( capacity , sizeof ( sstring ) ) ;
+  assert ( NULL != slots ) ;
+  for ( unsigned int i = 0 ; i < sstring_intern_capacity ; i ++ ) {
+    if ( NULL != sstring_intern_slots [ i ] ) {
+      * sstring_intern_find_slot ( slots , capacity , sstring_intern_slots [ i ] ) = sstring_intern_slots [ i ] ;
+    }
+  }
+  if ( 0 == sstring_intern_capacity ) {
+    atexit ( & sstring_intern_release ) ;
+  }
+  free ( sstring_intern_slots ) ;
+  sstring_intern_slots = slots ;
+  sstring_intern_capacity = capacity ;
+}
+
+
+/*!
+ * Get the canonical (interned) instance of a \c sstring.
+ *
+ * If no \c sstring with the same \c char sequence is interned, a copy of \c ss is interned.
+ * The returned \c sstring is shared: it must not be modified nor destroyed.
+ * Each call takes a reference to it that is given back with \link sstring_unintern() \endlink.
+ *
+ * \param ss \c sstring to intern (unchanged and still owned by the caller, unless it is already interned)
+ * \pre ss is a valid \c sstring (assert-ed)
+ * \return the interned \c sstring with the same \c char sequence as \c ss
+ */
+sstring sstring_intern ( sstring ss ) {
+  assert ( NULL != ss ) ;
+  if ( 0 < ss -> intern_count ) {
+    ss -> intern_count ++ ;
+    return ss ;
+  }
+  if ( 2 * ( sstring_intern_size + 1 ) > sstring_intern_capacity ) {
+    sstring_intern_grow () ;
+  }
+  sstring * const slot = sstring_intern_find_slot ( sstring_intern_slots , sstring_intern_capacity , ss ) ;
+  if ( NULL == * slot ) {
+    * slot = sstring_copy ( ss ) ;
+    sstring_hash ( * slot ) ;
+    sstring_intern_size ++ ;
+  }
+  ( * slot ) -> intern_count ++ ;
+  return * slot ;
+}
+
+
+/*!
+ * Give back a reference obtained with \link sstring_intern() \endlink.
+ *
+ * The last reference removes the \c sstring from the table and destroys it.
+ * The slot is filled back by shifting the following \c sstring's of its probe run, so that the table stays without deleted marks.
+ *
+ * \param ss interned \c sstring
+ * \pre ss is a valid interned \c sstring (assert-ed)
+ */
+void sstring_unintern ( sstring ss ) {
+  assert ( NULL != ss ) ;
+  assert ( 0 < ss -> intern_count ) ;
+  if ( 0 < -- ss -> intern_count ) {
+    return ;
+  }
+  unsigned int const mask = sstring_intern_capacity - 1 ;
+  unsigned int i = sstring_hash ( ss ) & mask ;
+  while ( ss != sstring_intern_slots [ i ] ) {
+    assert ( NULL != sstring_intern_slots [ i ] ) ;
+    i = ( i + 1 ) & mask ;
+  }
+  sstring_intern_slots [ i ] = NULL ;
+  for ( unsigned int j = ( i + 1 ) & mask ;
+	NULL != sstring_intern_slots [ j ] ;
+	j = ( j + 1 ) & mask ) {
+    unsigned int const home = sstring_hash ( sstring_intern_slots [ j ] ) & mask ;
+    // Move back unless its home slot lies in ]i,j] (cyclically)
+    if ( ( ( j - home ) & mask ) >= ( ( j - i ) & mask ) ) {
+      sstring_intern_slots [ i ] = sstring_intern_slots [ j ] ;
+      sstring_intern_slots [ j ] = NULL ;
+      i = j ;
+    }
+  }
+  sstring_intern_size -- ;
+  sstring_destroy ( ss ) ;
+}
+
+
+/*!
+ * Indicate whether a \c sstring is interned.
+ *
+ * \param ss \c sstring to test
+ * \pre ss is a valid \c sstring (assert-ed)
+ * \return true iff \c ss is the canonical instance returned by \link sstring_intern() \endlink
+ */
+bool sstring_is_interned ( sstring ss ) {
+  assert ( NULL != ss ) ;
+  return 0 < ss -> intern_count ;
+}
@@ -3,16 +3,26 @@
 
 # include <stdbool.h>
 # include <stdio.h>
+# include <stddef.h>
 
 
 /*!
  * \file
  * \brief This module provides a « safer » string.
  * 
- * These are not C-string but a \c struct that holds the length of the string and a pointer to the actual char sequence.
+ * These are not C-string but a \c struct that holds the length of the string and the actual char sequence.
  * Please note that there is no \c '\0' to mark the end of the \c sstring.
  *
- * Empty string is encoded by 0 \c length and \c NULL \c pointer.
+ * Scans of the \c char sequence (copy, comparison, search) are done through \c memcpy, \c memcmp and \c memchr.
+ * These are vectorized by the C library, which selects the best implementation for the CPU at run time.
+ *
+ * Short strings (up to \c SSTRING_INLINE_CAPACITY \c char's) are stored inline in the \c struct, so that they only need one allocation.
+ * Longer ones are stored in a separately allocated buffer.
+ * The buffer grows geometrically so that appending (\link sstring_concatenate() \endlink, \link sstring_append_char() \endlink) is amortized O(1).
+ *
+ * \c sstring's can be interned with \link sstring_intern() \endlink: there is then a single canonical instance for each \c char sequence.
+ * Interned \c sstring's have their hash precomputed and are compared by address.
+ * They are shared, must not be modified nor destroyed: each \link sstring_intern() \endlink is matched by a \link sstring_unintern() \endlink and the last one releases the instance (the ones still interned are released at exit).
  *
  * assert is enforced.
  *
@@ -47,11 +57,24 @@ extern sstring sstring_create_empty ( void ) ;
 extern sstring sstring_create_string ( char const * const st ) ;
 
 
+/*!
+ * Generate a \c sstring with the same \c char sequence as an array of \c char's.
+ *
+ * \param chars \c char's to copy (there is no need for a \c '\0')
+ * \param length number of \c char's
+ * \pre chars is not \c NULL unless \c length is 0 (assert-ed)
+ * \return a sstring with the \c length first \c char's of \c chars
+ */
+extern sstring sstring_create_chars ( char const * const chars ,
+				     unsigned int const length ) ;
+
+
 /*!
  * Destroy a \c sstring and release related resources.
  *
  * \param ss C-string to destroy
  * \pre ss is a valid \c sstring (assert-ed)
+ * \pre ss is not interned (assert-ed)
  */
 extern void sstring_destroy ( sstring ss ) ;
 
@@ -78,6 +101,34 @@ extern void sstring_print ( sstring ss ,
 extern void sstring_concatenate ( sstring ss1,
 				  sstring ss2 ) ;
 
+/*!
+ * Add a \c char at the end of a \c sstring.
+ *
+ * This is amortized O(1) so that a \c sstring can be built \c char by \c char in linear time.
+ *
+ * \param ss \c sstring to be modified
+ * \param c \c char to add
+ * \pre \c ss is a valid \c sstring (assert-ed)
+ * \pre \c ss is not interned (assert-ed)
+ */
+extern void sstring_append_char ( sstring ss ,
+				  char c ) ;
+
+/*!
+ * Add \c char's at the end of a \c sstring.
+ *
+ * \param ss \c sstring to be modified
+ * \param chars \c char's to add (there is no need for a \c '\0')
+ * \param length number of \c char's to add
+ * \pre \c ss is a valid \c sstring (assert-ed)
+ * \pre \c ss is not interned (assert-ed)
+ * \pre \c chars is not \c NULL (assert-ed)
+ */
+extern void sstring_append_chars ( sstring ss ,
+				   char const * const chars ,
+				   unsigned int const length ) ;
+
+
 /*!
  * Provide a copy of a string.
  *
@@ -114,5 +165,82 @@ extern int sstring_compare ( sstring ss1 ,
  */
 extern bool sstring_is_empty ( sstring ss ) ;
 
+/*!
+ * Hash of a \c sstring (FNV-1a over the \c char sequence).
+ *
+ * It is computed once and cached in the \c sstring until it is modified.
+ * Copies inherit the cached hash.
+ *
+ * \param ss \c sstring to hash
+ * \pre ss is a valid \c sstring (assert-ed)
+ * \return the hash of \c ss
+ */
+extern size_t sstring_hash ( sstring ss ) ;
+
+
+/*!
+ * Indicate whether two \c sstring are equal.
+ *
+ * Two interned \c sstring are only compared by address.
+ * Otherwise, if both hashes are already cached, they are compared first so that different \c sstring are usually told apart without looking at the \c char's.
+ * Hashes are not computed for this purpose: comparing the \c char's (with \c memcmp) is cheaper than hashing them.
+ *
+ * \param ss1 \c sstring 
+ * \param ss2 \c sstring 
+ * \pre ss1 and ss2 are valid \c sstring (assert-ed)
+ * \return true iff \c ss1 and \c ss2 hold the same \c char sequence
+ */
+extern bool sstring_equal ( sstring ss1 ,
+			    sstring ss2 ) ;
+
+
+/*!
+ * Search for a \c char in a \c sstring.
+ *
+ * \param ss \c sstring to search
+ * \param c \c char to look for
+ * \param from position to start the search from
+ * \pre ss is a valid \c sstring (assert-ed)
+ * \return the position of the first occurrence of \c c at or after \c from, or the length of \c ss if there is none
+ */
+extern unsigned int sstring_find_char ( sstring ss ,
+					char c ,
+					unsigned int from ) ;
+
+
+/*!
+ * Get the canonical (interned) instance of a \c sstring.
+ *
+ * If no \c sstring with the same \c char sequence is interned, a copy of \c ss is interned.
+ * The returned \c sstring is shared: it must not be modified nor destroyed.
+ * Each call takes a reference to it that is given back with \link sstring_unintern() \endlink.
+ *
+ * \param ss \c sstring to intern (unchanged and still owned by the caller, unless it is already interned)
+ * \pre ss is a valid \c sstring (assert-ed)
+ * \return the interned \c sstring with the same \c char sequence as \c ss
+ */
+extern sstring sstring_intern ( sstring ss ) ;
+
+
+/*!
+ * Give back a reference obtained with \link sstring_intern() \endlink.
+ *
+ * The last reference removes the \c sstring from the table and destroys it.
+ *
+ * \param ss interned \c sstring
+ * \pre ss is a valid interned \c sstring (assert-ed)
+ */
+extern void sstring_unintern ( sstring ss ) ;
+
+
+/*!
+ * Indicate whether a \c sstring is interned.
+ *
+ * \param ss \c sstring to test
+ * \pre ss is a valid \c sstring (assert-ed)
+ * \return true iff \c ss is the canonical instance returned by \link sstring_intern() \endlink
+ */
+extern bool sstring_is_interned ( sstring ss ) ;
+
 
 # endif
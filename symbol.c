@@ -0,0 +1,129 @@
+# include <stdlib.h>   // malloc + calloc + realloc + free + atexit
+# include <assert.h>
+
+# include "symbol.h"
+
+
+# undef NDEBUG   // FORCE ASSERT ACTIVATION
+
+
+
+/*!
+ * \file
+ * \brief Global table of symbols: each label name is interned once and identified by a small integer.
+ *
+ * Symbols are numbered consecutively from 0 in order of interning, so that they can be used as array indexes (f.e. by \link dictionary\endlink).
+ * The names are interned \c sstring's (see \link sstring_intern() \endlink) found through a hash table (indexed by \link sstring_hash() \endlink).
+ * They are never released before exit (registered with \c atexit).
+ *
+ * assert is enforced.
+ *
+ * \author Jérôme DURAND-LOSE
+ * \version 1
+ * \date 2015
+ * \copyright GNU Public License.
+ */
+
+
+/*! Initial number of slots of the hash table (must be a power of 2). */
+# define SYMBOL_INITIAL_CAPACITY 256
+
+
+/*! Names of the symbols, indexed by symbol. */
+static sstring * symbol_names = NULL ;
+
+/*! Number of interned symbols. */
+static unsigned int symbol_size = 0 ;
+
+/*! Hash table of the symbols (open addressing with linear probing), \link SYMBOL_NONE \endlink for a free slot. */
+static symbol * symbol_slots = NULL ;
+
+/*! Number of slots of the hash table (a power of 2), the array of names has half this size. */
+static unsigned int symbol_capacity = 0 ;
+
+
+/*!
+ * Release everything (registered with \c atexit).
+ */
+static void symbol_release ( void ) {
+  free ( symbol_names ) ;
+  free ( symbol_slots ) ;
+  symbol_names = NULL ;
+  symbol_slots = NULL ;
+  symbol_size = 0 ;
+  symbol_capacity = 0 ;
+}
+
+
+/*!
+ * Find the slot of a name: either the slot holding its symbol or the free slot where it should be inserted.
+ */
+static symbol * symbol_find_slot ( symbol * const slots ,
+				   unsigned int const capacity ,
+				   sstring const ss ) {
+  unsigned int const mask = capacity - 1 ;
+  unsigned int i = sstring_hash ( ss ) & mask ;
+  while ( ( SYMBOL_NONE != slots [ i ] )
+	  && ! sstring_equal ( ss , symbol_names [ slots [ i ] ] ) ) {
+    i = ( i + 1 ) & mask ;
+  }
+  return slots + i ;
+}
+
+
+/*!
+ * Double the hash table and the array of names (or allocate them on first use).
+ */
+static void symbol_grow ( void ) {
+  unsigned int const capacity = ( 0 == symbol_capacity ) ? SYMBOL_INITIAL_CAPACITY : 2 * symbol_capacity ;
+  symbol * const slots = ( symbol * ) malloc ( capacity * sizeof ( symbol ) ) ;
+  assert ( NULL != slots ) ;
+  for ( unsigned int i = 0 ; i < capacity ; i ++ ) {
+    slots [ i ] = SYMBOL_NONE ;
+  }
+  for ( symbol sy = 0 ; sy < symbol_size ; sy ++ ) {
+    * symbol_find_slot ( slots , capacity , symbol_names [ sy ] ) = sy ;
+  }
+  if ( 0 == symbol_capacity ) {
+    atexit ( & symbol_release ) ;
+  }
+  free ( symbol_slots ) ;
+  symbol_slots = slots ;
+  symbol_capacity = capacity ;
+  symbol_names = ( sstring * ) realloc ( symbol_names , ( capacity / 2 ) * sizeof ( sstring ) ) ;
+  assert ( NULL != symbol_names ) ;
+}
+
+
+symbol symbol_intern ( sstring ss ) {
+  assert ( NULL != ss ) ;
+  assert ( ! sstring_is_empty ( ss ) ) ;
+  if ( 2 * ( symbol_size + 1 ) > symbol_capacity ) {
+    symbol_grow () ;
+  }
+  symbol * const slot = symbol_find_slot ( symbol_slots , symbol_capacity , ss ) ;
+  if ( SYMBOL_NONE == * slot ) {
+    symbol_names [ symbol_size ] = sstring_intern ( ss ) ;
+    * slot = symbol_size ++ ;
+  }
+  return * slot ;
+}
+
+
+symbol symbol_find ( sstring ss ) {
+  assert ( NULL != ss ) ;
+  return ( 0 == symbol_capacity )
+    ? SYMBOL_NONE
+    : * symbol_find_slot ( symbol_slots , symbol_capacity , ss ) ;
+}
+
+
+sstring symbol_get_name ( symbol sy ) {
+  assert ( sy < symbol_size ) ;
+  return symbol_names [ sy ] ;
+}
+
+
+unsigned int symbol_number ( void ) {
+  return symbol_size ;
+}
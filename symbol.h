@@ -0,0 +1,73 @@
+# ifndef __SYMBOL_H
+# define __SYMBOL_H
+
+# include <limits.h>
+
+# include "sstring.h"
+
+
+/*!
+ * \file
+ * \brief Global table of symbols: each label name is interned once and identified by a small integer.
+ *
+ * Symbols are numbered consecutively from 0 in order of interning, so that they can be used as array indexes (f.e. by \link dictionary\endlink).
+ * The names are interned \c sstring's (see \link sstring_intern() \endlink) found through a hash table (indexed by \link sstring_hash() \endlink).
+ * They are never released before exit (registered with \c atexit).
+ *
+ * assert is enforced.
+ *
+ * \author Jérôme DURAND-LOSE
+ * \version 1
+ * \date 2015
+ * \copyright GNU Public License.
+ */
+
+
+/*! Identifier of an interned name. */
+typedef unsigned int symbol ;
+
+
+/*! Returned when a name is not interned. */
+# define SYMBOL_NONE UINT_MAX
+
+
+/*!
+ * Get the symbol of a name, the name is interned (a copy is made) if it is not already.
+ *
+ * \param ss name
+ * \pre \c ss is a valid non-empty \c sstring (assert-ed)
+ * \return the symbol of \c ss
+ */
+extern symbol symbol_intern ( sstring ss ) ;
+
+
+/*!
+ * Get the symbol of a name without interning it.
+ *
+ * \param ss name
+ * \pre \c ss is a valid \c sstring (assert-ed)
+ * \return the symbol of \c ss or \link SYMBOL_NONE \endlink if it is not interned
+ */
+extern symbol symbol_find ( sstring ss ) ;
+
+
+/*!
+ * Get the name of a symbol.
+ * It is \b not a copy but the interned \c sstring: it must neither be modified nor destroyed (it is valid until exit).
+ *
+ * \param sy symbol
+ * \pre \c sy is an interned symbol (assert-ed)
+ * \return the name of \c sy
+ */
+extern sstring symbol_get_name ( symbol sy ) ;
+
+
+/*!
+ * Number of interned symbols (symbols are all lower).
+ *
+ * \return the number of interned symbols
+ */
+extern unsigned int symbol_number ( void ) ;
+
+
+# endif
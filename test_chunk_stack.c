@@ -0,0 +1,80 @@
+# include <stdio.h>
+# include <assert.h>
+
+# include "chunk.h"
+
+# include "value_error.h"
+
+# include "chunk_stack.h"
+
+
+# undef NDEBUG   // FORCE ASSERT ACTIVATION
+
+/*!
+ * \file
+ * \brief Basic tests and examples of use of \c chunk_stack.
+ * All functions are tested on various values.
+ *
+ * This should also be used to test for memory leak.
+ *
+ * \author Jérôme DURAND-LOSE
+ * \version 1
+ * \date 2015
+ * \copyright GNU Public License.
+ */
+
+
+/*!
+ * Build a \c chunk_stack (large enough for the array to grow) and then do various stack modifications.
+ * Everything is destroyed in the end.
+ */
+int main ( void ) {
+  chunk_stack cs = chunk_stack_create () ;
+  assert ( chunk_stack_is_empty ( cs ) ) ;
+  assert ( NULL == chunk_stack_pop ( cs ) ) ;
+  assert ( NULL == chunk_stack_peek ( cs ) ) ;
+
+  for ( unsigned int i = 0 ; i < 6 ; i ++ ) {
+    chunk_stack_push ( cs , value_error_create ( i ) ) ;
+    fprintf ( stdout , "*** pushing : \"" ) ;
+    chunk_print ( chunk_stack_peek ( cs ) , stdout ) ;
+    fprintf ( stdout , "\" :\n" ) ;
+    chunk_stack_print ( cs , stdout ) ;
+  }
+  assert ( 6 == chunk_stack_size ( cs ) ) ;
+
+  fprintf ( stdout , "*** depth 0 to 6 :\n" ) ;
+  for ( unsigned int i = 0 ; i <= 6 ; i ++ ) {
+    chunk const ch = chunk_stack_nth ( cs , i ) ;
+    if ( NULL == ch ) {
+      fprintf ( stdout , "NULL\n" ) ;
+    } else {
+      chunk_print ( ch , stdout ) ;
+      fputc ( '\n' , stdout ) ;
+    }
+  }
+
+  fprintf ( stdout , "*** copy of 3 first elements :\n" ) ;
+  assert ( chunk_stack_dup_n ( cs , 3 ) ) ;
+  chunk_stack_print ( cs , stdout ) ;
+
+  fprintf ( stdout , "*** copy of 10 first elements (too many) :\n" ) ;
+  assert ( ! chunk_stack_dup_n ( cs , 10 ) ) ;
+  chunk_stack_print ( cs , stdout ) ;
+
+  fprintf ( stdout , "*** copy of all the elements (4 times) :\n" ) ;
+  for ( unsigned int i = 0 ; i < 4 ; i ++ ) {
+    assert ( chunk_stack_dup_n ( cs , chunk_stack_size ( cs ) ) ) ;
+  }
+  fprintf ( stdout , "%u elements\n" , chunk_stack_size ( cs ) ) ;
+
+  while ( 3 < chunk_stack_size ( cs ) ) {
+    chunk_destroy ( chunk_stack_pop ( cs ) ) ;
+  }
+  fprintf ( stdout , "*** down to 3 elements :\n" ) ;
+  chunk_stack_print ( cs , stdout ) ;
+
+  chunk_stack_destroy ( cs ) ;
+
+  return 0 ;
+}
@@ -50,6 +50,56 @@ static void test_dico_key_val ( dictionary const dic ,
 }
 
 
+/*!
+ * Define many keys in alphabetical order (so that the table has to grow and the tree to re-balance) and check that they can all be retrieved.
+ * Check removal on a copy.
+ * Nothing is printed unless there is an error.
+ */
+static void test_dico_many_keys ( dictionary const dic ,
+				  int const number ) {
+  char key_st [ 16 ] ;
+  for ( int i = 0 ; i < number ; i ++ ) {
+    sprintf ( key_st , "k%06d" , i ) ;
+    sstring key = sstring_create_string ( key_st ) ;
+    chunk val = value_int_create ( i ) ;
+    dictionary_set ( dic , key , val ) ;
+    chunk_destroy ( val ) ;
+    sstring_destroy ( key ) ;
+  }
+  // Every other key is removed from a copy
+  dictionary dic_2 = dictionary_copy ( dic ) ;
+  for ( int i = 0 ; i < number ; i += 2 ) {
+    sprintf ( key_st , "k%06d" , i ) ;
+    sstring key = sstring_create_string ( key_st ) ;
+    if ( ! dictionary_remove ( dic_2 , key ) ) {
+      fprintf ( stdout , "ERROR: cannot remove key %s\n" , key_st ) ;
+    }
+    sstring_destroy ( key ) ;
+  }
+  for ( int i = 0 ; i < number ; i ++ ) {
+    sprintf ( key_st , "k%06d" , i ) ;
+    sstring key = sstring_create_string ( key_st ) ;
+    chunk val_get = dictionary_get_copy ( dic , key ) ;
+    if ( ( NULL == val_get )
+	 || ( i != basic_type_get_long_long_int ( value_get_value ( val_get ) ) ) ) {
+      fprintf ( stdout , "ERROR: wrong value for key %s\n" , key_st ) ;
+    }
+    if ( NULL != val_get ) {
+      chunk_destroy ( val_get ) ;
+    }
+    val_get = dictionary_get_copy ( dic_2 , key ) ;
+    if ( ( 0 == i % 2 ) != ( NULL == val_get ) ) {
+      fprintf ( stdout , "ERROR: wrong removal for key %s\n" , key_st ) ;
+    }
+    if ( NULL != val_get ) {
+      chunk_destroy ( val_get ) ;
+    }
+    sstring_destroy ( key ) ;
+  }
+  dictionary_destroy ( dic_2 ) ;
+}
+
+
 /*!
  * Do some test on different keys, print and then redefine and then print and finally destroy the \c dictionary.
  */
@@ -73,8 +123,63 @@ int main ( void ) {
   test_dico_key_val ( dic , "etsd" , value_boolean_create ( false ) ) ;
 
   dictionary_print ( dic , stdout ) ;
+
+  // copy, removal and range
+
+  dictionary dic_2 = dictionary_copy ( dic ) ;
+  sstring key = sstring_create_string ( "Bun" ) ;
+  assert ( dictionary_remove ( dic_2 , key ) ) ;
+  assert ( ! dictionary_remove ( dic_2 , key ) ) ;
+  puts ( "*** copy without \"Bun\"" ) ;
+  dictionary_print ( dic_2 , stdout ) ;
+  dictionary_destroy ( dic_2 ) ;
+
+  // borrowed value held while redefined
+
+  chunk val_borrowed = dictionary_get_borrowed ( dic , key ) ;
+  dictionary_hold ( dic , symbol_find ( key ) ) ;
+  chunk val = value_int_create ( 66 ) ;
+  dictionary_set ( dic , key , val ) ;
+  chunk_destroy ( val ) ;
+  fputs ( "*** held: " , stdout ) ;
+  chunk_print ( val_borrowed , stdout ) ;
+  fputs ( " borrowed: " , stdout ) ;
+  chunk_print ( dictionary_get_borrowed ( dic , key ) , stdout ) ;
+  fputc ( '\n' , stdout ) ;
+  dictionary_release ( dic ) ;
+
+  // nested holds, the held value being removed then defined again
+
+  val = value_sstring_create ( sstring_create_string ( "held" ) ) ;
+  dictionary_set ( dic , key , val ) ;
+  chunk_destroy ( val ) ;
+  dictionary_hold ( dic , symbol_find ( key ) ) ;
+  val_borrowed = dictionary_get_borrowed ( dic , key ) ;
+  dictionary_hold ( dic , symbol_find ( key ) ) ;
+  assert ( dictionary_remove ( dic , key ) ) ;
+  val = value_int_create ( 77 ) ;
+  dictionary_set ( dic , key , val ) ;
+  chunk_destroy ( val ) ;
+  dictionary_release ( dic ) ;
+  fputs ( "*** held: " , stdout ) ;
+  chunk_print ( val_borrowed , stdout ) ;
+  fputs ( " borrowed: " , stdout ) ;
+  chunk_print ( dictionary_get_borrowed ( dic , key ) , stdout ) ;
+  fputc ( '\n' , stdout ) ;
+  dictionary_release ( dic ) ;
+
+  sstring last = sstring_create_string ( "Zzz" ) ;
+  puts ( "*** from \"Bun\" to \"Zzz\"" ) ;
+  dictionary_print_range ( dic , key , last , stdout ) ;
+  sstring_destroy ( key ) ;
+  sstring_destroy ( last ) ;
   
   dictionary_destroy ( dic ) ;
+
+  dic = dictionary_create () ;
+  test_dico_many_keys ( dic , 10000 ) ;
+  dictionary_destroy ( dic ) ;
+
   return 0 ;
 }
 
@@ -7,6 +7,8 @@
 
 # include "linked_list_chunk.h"
 
+# include "value_block.h"
+
 
 # undef NDEBUG   // FORCE ASSERT ACTIVATION
 
@@ -15,6 +17,8 @@
  * \brief Basic tests and examples of use of \c linked_list_chunk.
  * All functions are tested on various values.
  *
+ * \c value_block is also tested: copies share the \c linked_list_chunk until one of them is modified.
+ *
  * This should also be used to test for memory leak.
  *
  * \author Jérôme DURAND-LOSE
@@ -82,7 +86,18 @@ int main ( void ) {
   linked_list_chunk_add_self_copy_front ( llc_3 , 3 ) ;
   linked_list_chunk_print ( llc_3 , stdout ) ;
 
-  linked_list_chunk_destroy ( llc_3 );
+  chunk vb = value_block_create ( llc_3 ) ;
+  chunk vb_copy = chunk_copy ( vb ) ;
+  assert ( value_block_peek_list ( vb ) == value_block_peek_list ( vb_copy ) ) ;
+  chunk_destroy ( linked_list_chunk_pop_front ( value_block_get_list ( vb_copy ) ) ) ;
+  assert ( value_block_peek_list ( vb ) != value_block_peek_list ( vb_copy ) ) ;
+  fprintf ( stdout , "*** value_block: \n" ) ;
+  chunk_print ( vb , stdout ) ;
+  fprintf ( stdout , "\n*** modified copy of value_block: \n" ) ;
+  chunk_print ( vb_copy , stdout ) ;
+  fputc ( '\n' , stdout ) ;
+  chunk_destroy ( vb ) ;
+  chunk_destroy ( vb_copy ) ;
 
   return 0 ;
 }
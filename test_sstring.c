@@ -1,4 +1,5 @@
 # include <stdio.h>
+# include <stdlib.h>
 # include <string.h>
 # include <assert.h>
 
@@ -150,6 +151,98 @@ static void test_sstring ( char const * const st1 ,
 }
 
 
+/*!
+ * Build a \c sstring \c char by \c char (crossing the inline limit) and check it against a C-string.
+ */
+static void test_sstring_append_char ( char const * const st ) {
+  assert ( NULL != st ) ;
+  sstring ss = sstring_create_empty () ;
+  sstring ss_st = sstring_create_string ( st ) ;
+  for ( unsigned int i = 0 ; '\0' != st [ i ] ; i ++ ) {
+    sstring_append_char ( ss , st [ i ] ) ;
+  }
+  assert ( sstring_equal ( ss , ss_st ) ) ;
+  fputs ( "--------------- appended\n" , stdout ) ;
+  test_sstring_println ( ss ) ;
+  sstring_destroy ( ss ) ;
+  sstring_destroy ( ss_st ) ;
+}
+
+
+/*!
+ * Print all the positions of a \c char in a \c sstring.
+ */
+static void test_sstring_find_char ( char const * const st ,
+				     char const c ) {
+  assert ( NULL != st ) ;
+  sstring ss = sstring_create_string ( st ) ;
+  fprintf ( stdout , "--------------- '%c' in \"%s\" at:" , c , st ) ;
+  for ( unsigned int i = sstring_find_char ( ss , c , 0 ) ;
+	i < strlen ( st ) ;
+	i = sstring_find_char ( ss , c , i + 1 ) ) {
+    assert ( c == st [ i ] ) ;
+    fprintf ( stdout , " %u" , i ) ;
+  }
+  fputc ( '\n' , stdout ) ;
+  sstring_destroy ( ss ) ;
+}
+
+
+/*!
+ * Intern two \c sstring's with the same \c char sequence and check that they get the same canonical instance.
+ */
+static void test_sstring_intern ( char const * const st ) {
+  assert ( NULL != st ) ;
+  sstring ss1 = sstring_create_string ( st ) ;
+  sstring ss2 = sstring_create_string ( st ) ;
+  sstring const in1 = sstring_intern ( ss1 ) ;
+  sstring const in2 = sstring_intern ( ss2 ) ;
+  assert ( in1 == in2 ) ;
+  assert ( in1 == sstring_intern ( in1 ) ) ;
+  assert ( sstring_is_interned ( in1 ) ) ;
+  assert ( ! sstring_is_interned ( ss1 ) ) ;
+  assert ( sstring_equal ( in1 , ss2 ) ) ;
+  assert ( 0 == sstring_compare ( in1 , in2 ) ) ;
+  fputs ( "--------------- interned\n" , stdout ) ;
+  test_sstring_println ( in1 ) ;
+  sstring_unintern ( in1 ) ;
+  sstring_unintern ( in2 ) ;
+  assert ( sstring_is_interned ( in1 ) ) ;
+  sstring_unintern ( in1 ) ;
+  sstring_destroy ( ss1 ) ;
+  sstring_destroy ( ss2 ) ;
+}
+
+
+/*!
+ * Intern many \c sstring's, give back every other one and check that the remaining ones are still found.
+ */
+static void test_sstring_unintern ( unsigned int const n ) {
+  sstring * const in = ( sstring * ) malloc ( n * sizeof ( sstring ) ) ;
+  assert ( NULL != in ) ;
+  char buffer [ 32 ] ;
+  for ( unsigned int i = 0 ; i < n ; i ++ ) {
+    snprintf ( buffer , sizeof ( buffer ) , "s%u" , i ) ;
+    sstring const ss = sstring_create_string ( buffer ) ;
+    in [ i ] = sstring_intern ( ss ) ;
+    sstring_destroy ( ss ) ;
+  }
+  for ( unsigned int i = 0 ; i < n ; i += 2 ) {
+    sstring_unintern ( in [ i ] ) ;
+  }
+  for ( unsigned int i = 1 ; i < n ; i += 2 ) {
+    snprintf ( buffer , sizeof ( buffer ) , "s%u" , i ) ;
+    sstring const ss = sstring_create_string ( buffer ) ;
+    assert ( in [ i ] == sstring_intern ( ss ) ) ;
+    sstring_destroy ( ss ) ;
+    sstring_unintern ( in [ i ] ) ;
+    sstring_unintern ( in [ i ] ) ;
+  }
+  free ( in ) ;
+  fprintf ( stdout , "--------------- %u interned and given back\n" , n ) ;
+}
+
+
 /*!
  * Launch \link\c test_sstring_test() \enlink on various cases including empty C-string.
  */
@@ -161,6 +254,20 @@ int main ( void ) {
   test_sstring ( "" , "" ) ;
 
   test_sstring ( "rou\ndoudou" , "unfzer\n_5\tdf" ) ;
+
+  test_sstring ( "inline_label" , "a string too long to be stored inline" ) ;
+  test_sstring ( "a string too long to be stored inline" , "another string too long to be stored inline" ) ;
+
+  test_sstring_append_char ( "roudoudou" ) ;
+  test_sstring_append_char ( "a string too long to be stored inline and long enough to be reallocated" ) ;
+
+  test_sstring_find_char ( "roudoudou" , 'o' ) ;
+  test_sstring_find_char ( "roudoudou" , 'z' ) ;
+  test_sstring_find_char ( "a string too long to be stored inline" , ' ' ) ;
+
+  test_sstring_intern ( "roudoudou" ) ;
+  test_sstring_intern ( "a string too long to be stored inline" ) ;
+  test_sstring_unintern ( 1000 ) ;
   
   return 0 ;
 }
@@ -2,14 +2,24 @@
 
 # include "value.h"
 
+# include "value_int.h"
+# include "value_boolean.h"
+
 
 # undef NDEBUG   // FORCE ASSERT ACTIVATION
 
 
+chunk_struct const * const chunk_immediate_class [] = {
+  [ CHUNK_TAG_POINTER ] = NULL ,
+  [ CHUNK_TAG_INT ] = & value_int_immediate_class ,
+  [ CHUNK_TAG_BOOLEAN ] = & value_boolean_immediate_class ,
+  [ CHUNK_TAG_MASK ] = NULL
+} ;
+
+
 bool chunk_is_value ( chunk const ch ) {
   assert ( NULL != ch ) ;
-  // Do not use get_boolean since false should be returned for error
-  return t_true == chunk_answer_message ( ch , MESSAGE_VALUE_IS_VALUE ).type;
+  return NULL != chunk_header ( ch ) -> vtable -> get_value ;
 }
 
 
@@ -19,8 +29,13 @@ basic_type chunk_is_value_true ( chunk const ch ,
 }
 
 
+basic_type value_get_value_message ( chunk const ch ,
+				     va_list va ) {
+  return ( * ( chunk_header ( ch ) -> vtable -> get_value ) ) ( ch ) ;
+}
+
+
 basic_type value_get_value ( chunk const ch ) {
   assert ( chunk_is_value ( ch ) ) ;
-  return chunk_answer_message ( ch , MESSAGE_VALUE_GET_VALUE ) ;
+  return ( * ( chunk_header ( ch ) -> vtable -> get_value ) ) ( ch ) ;
 }
-
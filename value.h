@@ -15,6 +15,7 @@
  * A \c chunk is a \c value if it gives a positive response to the message \link MESSAGE_VALUE_IS_VALUE \endlink.
  *
  * \c value's must also respond to the message \link MESSAGE_VALUE_GET_VALUE \endlink.
+ * Both are answered through the \c chunk_vtable: a \c chunk is a \c value iff its \c get_value entry is set.
  *
  * There is no \c …_create
  * This it thought as an abstract intermediary class.
@@ -30,7 +31,7 @@
 
 /*!
  * Test whether a chunk is a value.
- * It is done by sending the \link MESSAGE_VALUE_IS_VALUE \endlink message and decoding the response (or the absence of).
+ * It is done by checking the \c get_value entry of its \c chunk_vtable (same answer as to the \link MESSAGE_VALUE_IS_VALUE \endlink message).
  *
  * \param ch \c chunk to test
  * \pre \c ch must not be \c NULL (assert-ed)
@@ -53,7 +54,7 @@ extern basic_type chunk_is_value_true ( chunk const ch ,
 
 /*!
  * Return the value held in a \c value.
- * It is done by sending the \link MESSAGE_VALUE_get_VALUE \endlink message and decoding the response.
+ * It is done by calling the \c get_value entry of its \c chunk_vtable (same answer as to the \link MESSAGE_VALUE_GET_VALUE \endlink message).
  *
  * \param ch \c chunk to query
  * \pre \c ch must be a value (assert-ed)
@@ -70,14 +71,37 @@ extern basic_type value_get_value ( chunk const ch ) ;
 # define MESSAGE_VALUE_GET_VALUE "value_get_value"
 
 
+/*!
+ * Action for \link MESSAGE_VALUE_GET_VALUE \endlink: forwards to the \c get_value entry of the \c chunk_vtable.
+ * It is shared by all classes.
+ *
+ * \param ch \c chunk to query
+ * \param va unused extra arguments
+ * \return the held value
+ */
+extern basic_type value_get_value_message ( chunk const ch ,
+					    va_list va ) ;
+
+
 /*!
  * Enlarged message_action array for values.
  * Directly sets \c chunk_is_value_true.
  */
-# define MESSAGE_ACTION__BASIC_VALUE( type )			\
-  MESSAGE_ACTION__BASIC_PARAM( value_ , type ) ,		\
+# define MESSAGE_ACTION__BASIC_VALUE				\
+  MESSAGE_ACTION__BASIC ,					\
   { MESSAGE_VALUE_IS_VALUE , & chunk_is_value_true } ,		\
-  { MESSAGE_VALUE_GET_VALUE , & value_ ## type ## _get_value }
+  { MESSAGE_VALUE_GET_VALUE , & value_get_value_message }
+
+
+/*!
+ * Enlarged \c chunk_vtable entries for values.
+ * <tt>value_ ## type ## _get_value</tt> must be defined with the typed signature.
+ *
+ * \param type to indicate the proper name of the value type
+ */
+# define CHUNK_VTABLE__BASIC_VALUE( type )			\
+  CHUNK_VTABLE__BASIC_PARAM( value_ , type ) ,			\
+  .get_value = & value_ ## type ## _get_value
 
 
 # endif
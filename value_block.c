@@ -21,7 +21,13 @@
  * The \c linked_list_chunk can be accessed and manipulated directly with \link value_block_get_list() \endlink.
  * Thus \c value_block is \em mutable.
  *
- * Copies are distinct (deep copy of the structure) so that acting on one does not modify any copy.
+ * Copies share the same \c linked_list_chunk through a reference count so that copying is O(1) whatever the size of the block.
+ * The \c linked_list_chunk is only duplicated on mutation (copy-on-write): \link value_block_get_list() \endlink first detaches the \c value_block from its copies if it is shared.
+ * So that acting on one does not modify any copy.
+ * Read-only access that never duplicates is provided by \link value_block_peek_list() \endlink.
+ *
+ * The list is compiled to a \c bytecode the first time it is needed (\link value_block_get_bytecode() \endlink).
+ * The \c bytecode is shared by the copies and discarded when the list is modified.
  *
  * Its output is like:
  * \verbatim
@@ -34,6 +40,8 @@
  true
  } \endverbatim
  *
+ * The \c linked_list_chunk given on creation belongs to the \c value_block from now on.
+ *
  * In input, spaces and newlines are meaningless as long as the order of \c chunk's are preserved and they are separated, as in any \c pf program.
  *
  * assert is enforced.
@@ -45,18 +53,132 @@
  */
 
 
-VALUE_DECLARE ( block , linked_list_chunk )
+/*!
+ * The \c linked_list_chunk shared by copies of a \c value_block with the number of copies sharing it.
+ * \c code is its \c bytecode, \c NULL if not compiled yet.
+ */
+typedef struct {
+  unsigned int copies_count ;
+  linked_list_chunk list ;
+  bytecode code ;
+} value_block_payload_struct ,
+  * value_block_payload ;
 
 
 /*!
- * Return the \c linked_list_chunk held.
- *
- * This is not a copy but a direct access.
- *
- * \param vb chunk to query
- * \pre \c vb must be a \c value_block (assert-ed)
- * \return the \c linked_list_chunk held
+ * Each copy is a distinct \c chunk that points to a (possibly shared) payload.
+ */
+typedef struct {
+  value_block_payload payload ;
+} value_block_state_struct ,
+  * value_block_state ;
+
+
+static value_block_payload value_block_payload_create ( linked_list_chunk const list ) {
+  value_block_payload const pl = ( value_block_payload ) malloc ( sizeof ( value_block_payload_struct ) ) ;
+  assert ( NULL != pl ) ;
+  pl -> copies_count = 1 ;
+  pl -> list = list ;
+  pl -> code = NULL ;
+  return pl ;
+}
+
+
+static void value_block_payload_release ( value_block_payload const pl ) {
+  if ( 1 == pl -> copies_count -- ) {
+    if ( NULL != pl -> code ) {
+      bytecode_destroy ( pl -> code ) ;
+    }
+    linked_list_chunk_destroy ( pl -> list ) ;
+    free ( pl ) ;
+  }
+}
+
+
+static basic_type value_block_get_value ( chunk const ch ) {
+  return basic_type_pointer ( ( ( value_block_state ) ( ch -> state ) ) -> payload -> list ) ;
+}
+
+
+static basic_type value_block_print ( chunk const ch ,
+				      FILE * const f ) {
+  fputs ( "{\n" , f ) ;
+  linked_list_chunk_print ( ( ( value_block_state ) ( ch -> state ) ) -> payload -> list , f ) ;
+  fputc ( '}' , f ) ;
+  return basic_type_void ;
+}
+
+
+static basic_type value_block_destroy ( chunk const ch ) {
+  value_block_payload_release ( ( ( value_block_state ) ( ch -> state ) ) -> payload ) ;
+  VALUE_CHUNK_RELEASE ( block , ch ) ;
+  return basic_type_void ;
+}
+
+
+static const message_action value_block_reactions [] = {
+  MESSAGE_ACTION__BASIC_VALUE ,
+  { NULL, NULL }
+} ;
+
+
+static chunk value_block_copy ( chunk const ch ) ;
+
+
+static const chunk_vtable value_block_vtable = {
+  CHUNK_VTABLE__BASIC_VALUE( block )
+} ;
+
+
+/*!
+ * A new \c chunk sharing the payload (no copy of the \c linked_list_chunk).
  */
-linked_list_chunk value_block_get_list ( chunk const vb )  { return NULL ; }
+static chunk value_block_copy ( chunk const ch ) {
+  value_block_payload const pl = ( ( value_block_state ) ( ch -> state ) ) -> payload ;
+  pl -> copies_count ++ ;
+  chunk const ch_copy = VALUE_CHUNK_ALLOCATE ( block ) ;
+  ( ( value_block_state ) ( ch_copy -> state ) ) -> payload = pl ;
+  return ch_copy ;
+}
+
+
+chunk value_block_create ( linked_list_chunk const list ) {
+  assert ( NULL != list ) ;
+  chunk ch = VALUE_CHUNK_ALLOCATE ( block ) ;
+  ( ( value_block_state ) ( ch -> state ) ) -> payload = value_block_payload_create ( list ) ;
+  return ch ;
+}
+
+
+VALUE_IS_FULL( block )
+
+
+linked_list_chunk value_block_get_list ( chunk const vb ) {
+  assert ( value_is_block ( vb ) ) ;
+  value_block_state const st = ( value_block_state ) ( vb -> state ) ;
+  if ( 1 < st -> payload -> copies_count ) {
+    value_block_payload const pl = value_block_payload_create ( linked_list_chunk_copy ( st -> payload -> list ) ) ;
+    value_block_payload_release ( st -> payload ) ;
+    st -> payload = pl ;
+  } else if ( NULL != st -> payload -> code ) {
+    bytecode_destroy ( st -> payload -> code ) ;
+    st -> payload -> code = NULL ;
+  }
+  return st -> payload -> list ;
+}
+
+
+linked_list_chunk value_block_peek_list ( chunk const vb ) {
+  assert ( value_is_block ( vb ) ) ;
+  return ( ( value_block_state ) ( vb -> state ) ) -> payload -> list ;
+}
 
 
+bytecode value_block_get_bytecode ( chunk const vb ) {
+  assert ( value_is_block ( vb ) ) ;
+  value_block_payload const pl = ( ( value_block_state ) ( vb -> state ) ) -> payload ;
+  if ( NULL == pl -> code ) {
+    pl -> code = bytecode_compile ( pl -> list ) ;
+  }
+  return pl -> code ;
+}
@@ -8,6 +8,7 @@
 # include "macro_value.h"
 
 # include "linked_list_chunk.h"
+# include "bytecode.h"
 
 
 /*!
@@ -17,7 +18,13 @@
  * The \c linked_list_chunk can be accessed and manipulated directly with \link value_block_get_list() \endlink.
  * Thus \c value_block is \em mutable.
  *
- * Copies are distinct (deep copy of the structure) so that acting on one does not modify any copy.
+ * Copies share the same \c linked_list_chunk through a reference count so that copying is O(1) whatever the size of the block.
+ * The \c linked_list_chunk is only duplicated on mutation (copy-on-write): \link value_block_get_list() \endlink first detaches the \c value_block from its copies if it is shared.
+ * So that acting on one does not modify any copy.
+ * Read-only access that never duplicates is provided by \link value_block_peek_list() \endlink.
+ *
+ * The list is compiled to a \c bytecode the first time it is needed (\link value_block_get_bytecode() \endlink).
+ * The \c bytecode is shared by the copies and discarded when the list is modified.
  *
  * Its output is like:
  * \verbatim
@@ -30,6 +37,8 @@
  true
  } \endverbatim
  *
+ * The \c linked_list_chunk given on creation belongs to the \c value_block from now on.
+ *
  * In input, spaces and newlines are meaningless as long as the order of \c chunk's are preserved and they are separated, as in any \c pf program.
  *
  * assert is enforced.
@@ -47,13 +56,39 @@ VALUE_DECLARE ( block , linked_list_chunk )
 /*!
  * Return the \c linked_list_chunk held.
  *
- * This is not a copy but a direct access.
+ * This is not a copy but a direct access that can be used to modify the \c linked_list_chunk.
+ * If it is shared with other copies, it is first duplicated so that the copies are not affected.
  *
  * \param vb chunk to query
  * \pre \c vb must be a \c value_block (assert-ed)
- * \return the \c linked_list_chunk held
+ * \return the \c linked_list_chunk held (not shared)
  */
 extern linked_list_chunk value_block_get_list ( chunk const vb ) ;
 
 
+/*!
+ * Return the \c linked_list_chunk held, which may be shared with copies.
+ *
+ * This is a direct access that is \b not to be used to modify the \c linked_list_chunk.
+ * It remains valid as long as \c vb is not destroyed (nor modified through \link value_block_get_list() \endlink).
+ *
+ * \param vb chunk to query
+ * \pre \c vb must be a \c value_block (assert-ed)
+ * \return the \c linked_list_chunk held
+ */
+extern linked_list_chunk value_block_peek_list ( chunk const vb ) ;
+
+
+/*!
+ * Return the \c bytecode of the \c linked_list_chunk held (compiled at the first call).
+ *
+ * It is shared with copies and remains valid as long as \c vb is not destroyed (nor modified through \link value_block_get_list() \endlink).
+ *
+ * \param vb chunk to query
+ * \pre \c vb must be a \c value_block (assert-ed)
+ * \return the \c bytecode of the \c linked_list_chunk held
+ */
+extern bytecode value_block_get_bytecode ( chunk const vb ) ;
+
+
 # endif
@@ -18,6 +18,8 @@
  *
  * For I/O, they appear as keyword \c true and \c false.
  *
+ * A \c value_boolean is always an immediate \c chunk: there is no allocation and \c copy and \c destroy do nothing.
+ *
  * assert is enforced.
  *
  * \author Jérôme DURAND-LOSE
@@ -41,6 +43,54 @@
 # define VALUE_BOOLEAN_STRING_FALSE "false"
 
 
-VALUE_DECLARE ( boolean , bool )
+static basic_type value_boolean_get_value ( chunk const ch ) {
+  return basic_type_boolean ( 0 != chunk_immediate_get_payload ( ch ) ) ; 
+}
+
+
+static basic_type value_boolean_print ( chunk const ch ,
+					FILE * const f ) {
+  fputs ( ( 0 != chunk_immediate_get_payload ( ch ) )
+	  ? VALUE_BOOLEAN_STRING_TRUE
+	  : VALUE_BOOLEAN_STRING_FALSE ,
+	  f ) ;
+  return basic_type_void ;
+}
+
+
+static basic_type value_boolean_destroy ( chunk const ch ) {
+  return basic_type_void ;
+}
+
+
+static chunk value_boolean_copy ( chunk const ch ) {
+  return ch ; 
+}
+
+
+static const message_action value_boolean_reactions [] = {
+  MESSAGE_ACTION__BASIC_VALUE ,
+  { NULL, NULL }
+} ;
+
+
+static const chunk_vtable value_boolean_vtable = {
+  CHUNK_VTABLE__BASIC_VALUE( boolean )
+} ;
+
+
+chunk_struct const value_boolean_immediate_class = {
+  .reactions = value_boolean_reactions ,
+  .vtable = & value_boolean_vtable ,
+  .state = NULL
+} ;
+
+
+chunk value_boolean_create ( bool const val ) {
+  return chunk_immediate_create ( CHUNK_TAG_BOOLEAN , val ? 1 : 0 ) ;
+}
+
+
+VALUE_IS_FULL( boolean )
 
 
@@ -14,6 +14,8 @@
  *
  * For I/O, they appear as keyword \c true and \c false.
  *
+ * A \c value_boolean is always an immediate \c chunk: there is no allocation and \c copy and \c destroy do nothing.
+ *
  * assert is enforced.
  *
  * \author Jérôme DURAND-LOSE
@@ -40,4 +42,11 @@
 VALUE_DECLARE ( boolean , bool )
 
 
+/*!
+ * Class of the immediate \c value_boolean (see \link chunk_immediate_class \endlink).
+ * All booleans are immediates.
+ */
+extern chunk_struct const value_boolean_immediate_class ;
+
+
 # endif
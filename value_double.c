@@ -16,7 +16,7 @@
 
 /*!
  * \file 
- * \brief \c value used to hold a \c double.
+ * \brief \c value used to hold a float (a \c basic_float, i.e. a \c double unless \c long double's are selected at compilation).
  *
  * For I/O these are just numbers with decimal point like 78.0 0.75 -568.58.
  * No exponential form is supported.
@@ -30,6 +30,63 @@
  */
 
 
-VALUE_DECLARE( double , long double ) 
+/*!
+ * The float is shared between copies.
+ */
+typedef struct {
+  unsigned int copies_count ;
+  basic_float val ;
+} value_double_state_struct ,
+  * value_double_state ;
+
+
+static basic_type value_double_get_value ( chunk const ch ) {
+  return basic_type_float ( ( ( value_double_state ) ( ch -> state ) ) -> val ) ; 
+}
+
+
+static basic_type value_double_print ( chunk const ch ,
+				       FILE * const f ) {
+  fprintf ( f , BASIC_FLOAT_FORMAT , ( ( value_double_state ) ( ch -> state ) ) -> val ) ;
+  return basic_type_void ;
+}
+
+
+static basic_type value_double_destroy ( chunk const ch ) {
+  if ( 1 == ( ( value_double_state ) ( ch -> state ) ) -> copies_count -- ) {
+    VALUE_CHUNK_RELEASE ( double , ch ) ;
+  }
+  return basic_type_void ;
+}
+
+
+static chunk value_double_copy ( chunk const ch ) {
+  ( ( value_double_state ) ( ch -> state ) ) -> copies_count ++ ;
+  return ch ; 
+}
+
+
+static const message_action value_double_reactions [] = {
+  MESSAGE_ACTION__BASIC_VALUE ,
+  { NULL, NULL }
+} ;
+
+
+static const chunk_vtable value_double_vtable = {
+  CHUNK_VTABLE__BASIC_VALUE( double )
+} ;
+
+
+chunk value_double_create ( basic_float const val ) {
+  //  Allocation (chunk and state in one block)
+  chunk ch = VALUE_CHUNK_ALLOCATE ( double ) ;
+  //  Initialisation
+  ( ( value_double_state ) ( ch -> state ) ) -> copies_count = 1 ;
+  ( ( value_double_state ) ( ch -> state ) ) -> val = val ;
+  return ch ;
+}
+
+
+VALUE_IS_FULL( double )
 
 
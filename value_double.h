@@ -8,7 +8,7 @@
 
 /*!
  * \file 
- * \brief \c value used to hold a \c double.
+ * \brief \c value used to hold a float (a \c basic_float, i.e. a \c double unless \c long double's are selected at compilation).
  *
  * For I/O these are just numbers with decimal point like 78.0 0.75 -568.58.
  * No exponential form is supported.
@@ -22,7 +22,7 @@
  */
 
 
-VALUE_DECLARE( double , long double ) 
+VALUE_DECLARE( double , basic_float ) 
 
 
 # endif
@@ -19,6 +19,7 @@ static char const * const value_error_string = "--error-- #" ;
 
 /*!
  * Just record the error nbr as enum \link error_code \endlink.
+ * \c copies_count is meaningless for the immortal \c value_error's.
  */
 typedef struct {
   unsigned int copies_count ;
@@ -27,16 +28,30 @@ typedef struct {
   * value_error_state ;
 
 
+/*!
+ * Number of immortal \c value_error's: one for each \link error_code \endlink and one for 0.
+ */
+# define VALUE_ERROR_IMMORTAL_NUMBER ( VALUE_ERROR_TOO_DEEP + 1 )
+
+static chunk_struct value_error_immortals [ VALUE_ERROR_IMMORTAL_NUMBER ] ;
+
+
+/*!
+ * Test whether a \c value_error is one of the immortal ones (its \c copy and \c destroy do nothing).
+ */
+static inline bool value_error_is_immortal ( chunk const ch ) {
+  return ( value_error_immortals <= ch ) && ( ch < value_error_immortals + VALUE_ERROR_IMMORTAL_NUMBER ) ;
+}
+
 
-static basic_type value_error_get_value ( chunk const ch ,
-					  va_list va ) {
-  return basic_type_long_long_int ( ( ( value_error_state ) ch ) -> error ) ; 
+
+static basic_type value_error_get_value ( chunk const ch ) {
+  return basic_type_long_long_int ( ( ( value_error_state ) ( ch -> state ) ) -> error ) ; 
 }
 
 
 static basic_type value_error_print ( chunk const ch ,
-				      va_list va ) {
-  FILE * f = va_arg ( va , FILE * ) ;
+				      FILE * const f ) {
   fprintf ( f
 	    , "%s %u"
 	    , value_error_string
@@ -45,42 +60,85 @@ static basic_type value_error_print ( chunk const ch ,
 }
 
 
-static basic_type value_error_destroy ( chunk const ch ,
-					va_list va ) {
+static basic_type value_error_destroy ( chunk const ch ) {
+  if ( value_error_is_immortal ( ch ) ) {
+    return basic_type_void ;
+  }
   if ( 1 == ( ( value_error_state  ) ( ch -> state ) ) -> copies_count -- ) {
-    free ( ch -> state ) ;  
-    ch -> state = NULL ;
-    ch -> reactions = NULL ;
-    free ( ch ) ;
+    VALUE_CHUNK_RELEASE ( error , ch ) ;
   }
   return basic_type_void ;
 }
 
 
-static basic_type value_error_copy ( chunk const ch ,
-				     va_list va ) {
+static chunk value_error_copy ( chunk const ch ) {
   // not commented since it has to be explained
+  if ( value_error_is_immortal ( ch ) ) {
+    return ch ;
+  }
   ( ( value_error_state ) ( ch -> state ) ) -> copies_count ++ ;
-  return basic_type_pointer( ch ) ; 
+  return ch ; 
 }
 
 
 static const message_action value_error_reactions [] = {
-  MESSAGE_ACTION__BASIC_VALUE( error ) ,
+  MESSAGE_ACTION__BASIC_VALUE ,
   { NULL, NULL }
 } ;
 
 
+static const chunk_vtable value_error_vtable = {
+  CHUNK_VTABLE__BASIC_VALUE( error )
+} ;
+
+
+/*! States of the immortal \c value_error's. */
+static value_error_state_struct value_error_immortal_states [ VALUE_ERROR_IMMORTAL_NUMBER ] = {
+  { 0 , 0 } ,
+  { 0 , VALUE_ERROR_IO_SYNTAX } ,
+  { 0 , VALUE_ERROR_IO_EOF } ,
+  { 0 , VALUE_ERROR_IO_MALFORMED_STRING } ,
+  { 0 , VALUE_ERROR_IO_UNFINISHED_BLOCK } ,
+  { 0 , VALUE_ERROR_IO_LABEL_IS_KEYWORD } ,
+  { 0 , VALUE_ERROR_IO_LABEL_EMPTY } ,
+  { 0 , VALUE_ERROR_EMPTY_STACK } ,
+  { 0 , VALUE_ERROR_ILLEGAL_OPERAND } ,
+  { 0 , VALUE_ERROR_UNDEFINED_LABEL } ,
+  { 0 , VALUE_ERROR_TOO_DEEP } ,
+} ;
+
+
+/*! Immortal \c value_error number \c i. */
+# define VALUE_ERROR_IMMORTAL( i )					\
+  { value_error_reactions , & value_error_vtable , & value_error_immortal_states [ i ] }
+
+static chunk_struct value_error_immortals [ VALUE_ERROR_IMMORTAL_NUMBER ] = {
+  VALUE_ERROR_IMMORTAL ( 0 ) ,
+  VALUE_ERROR_IMMORTAL ( 1 ) ,
+  VALUE_ERROR_IMMORTAL ( 2 ) ,
+  VALUE_ERROR_IMMORTAL ( 3 ) ,
+  VALUE_ERROR_IMMORTAL ( 4 ) ,
+  VALUE_ERROR_IMMORTAL ( 5 ) ,
+  VALUE_ERROR_IMMORTAL ( 6 ) ,
+  VALUE_ERROR_IMMORTAL ( 7 ) ,
+  VALUE_ERROR_IMMORTAL ( 8 ) ,
+  VALUE_ERROR_IMMORTAL ( 9 ) ,
+  VALUE_ERROR_IMMORTAL ( 10 ) ,
+} ;
+
+# undef VALUE_ERROR_IMMORTAL
+
+
 chunk value_error_create ( error_code const error ) {
-  //  Allocation
-  chunk ch = ( chunk ) malloc ( sizeof ( chunk_struct ) ) ; 
-  assert ( NULL != ch ) ;
-  ch -> state = malloc ( sizeof ( value_error_state ) ) ; 
-  assert ( NULL != ch -> state ) ;
+  //  Known codes are shared (no allocation)
+  if ( ( unsigned int ) error < VALUE_ERROR_IMMORTAL_NUMBER ) {
+    return & value_error_immortals [ error ] ;
+  }
+  //  Allocation (chunk and state in one block)
+  chunk ch = VALUE_CHUNK_ALLOCATE ( error ) ;
   //  Initialisation
   ( ( value_error_state ) ( ch -> state ) ) -> copies_count = 1 ;
   ( ( value_error_state ) ( ch -> state ) ) -> error = error ;
-  ch -> reactions = value_error_reactions ;
   return ch ;
 }
 
@@ -19,6 +19,9 @@
  *
  * Output is like <tt>--error-- #</tt> followed by the error number.
  *
+ * There is a single, immortal, \c value_error for each \link error_code \endlink (and for 0): it is not allocated and its \c copy and \c destroy do nothing.
+ * Only other codes lead to allocated (and reference counted) \c value_error's.
+ *
  * assert is enforced.
  *
  * \author Jérôme DURAND-LOSE
@@ -42,6 +45,7 @@ typedef enum {
   VALUE_ERROR_EMPTY_STACK = 7 ,
   VALUE_ERROR_ILLEGAL_OPERAND = 8 ,
   VALUE_ERROR_UNDEFINED_LABEL = 9 ,
+  VALUE_ERROR_TOO_DEEP = 10 ,
 } error_code ;
 
 
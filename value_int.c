@@ -21,6 +21,9 @@
  * \li '-' sign if negative (nothing for positive) followed by
  * \li sequence of digits.
  *
+ * A \c value_int is an immediate \c chunk whenever the integer fits in its payload, so that creating, copying and destroying it involves no allocation.
+ * Otherwise it is stored in an allocated state shared between copies.
+ *
  * assert is enforced.
  *
  * \author Jérôme DURAND-LOSE
@@ -30,7 +33,88 @@
  */
 
 
-VALUE_DECLARE( int , long long int ) 
+/*!
+ * State of an integer too large to be an immediate.
+ */
+typedef struct {
+  unsigned int copies_count ;
+  long long int val ;
+} value_int_state_struct ,
+  * value_int_state ;
+
+
+/*!
+ * Integer held by a \c value_int, whether immediate or not.
+ */
+# define VALUE_INT_GET( ch )						\
+  ( chunk_is_immediate ( ch )						\
+    ? ( long long int ) chunk_immediate_get_payload ( ch )		\
+    : ( ( value_int_state ) ( ( ch ) -> state ) ) -> val )
+
+
+static basic_type value_int_get_value ( chunk const ch ) {
+  return basic_type_long_long_int ( VALUE_INT_GET ( ch ) ) ; 
+}
+
+
+static basic_type value_int_print ( chunk const ch ,
+				    FILE * const f ) {
+  fprintf ( f , "%lld" , VALUE_INT_GET ( ch ) ) ;
+  return basic_type_void ;
+}
+
+
+static basic_type value_int_destroy ( chunk const ch ) {
+  if ( chunk_is_immediate ( ch ) ) {
+    return basic_type_void ;
+  }
+  if ( 1 == ( ( value_int_state ) ( ch -> state ) ) -> copies_count -- ) {
+    VALUE_CHUNK_RELEASE ( int , ch ) ;
+  }
+  return basic_type_void ;
+}
+
+
+static chunk value_int_copy ( chunk const ch ) {
+  if ( ! chunk_is_immediate ( ch ) ) {
+    ( ( value_int_state ) ( ch -> state ) ) -> copies_count ++ ;
+  }
+  return ch ; 
+}
+
+
+static const message_action value_int_reactions [] = {
+  MESSAGE_ACTION__BASIC_VALUE ,
+  { NULL, NULL }
+} ;
+
+
+static const chunk_vtable value_int_vtable = {
+  CHUNK_VTABLE__BASIC_VALUE( int )
+} ;
+
+
+chunk_struct const value_int_immediate_class = {
+  .reactions = value_int_reactions ,
+  .vtable = & value_int_vtable ,
+  .state = NULL
+} ;
+
+
+chunk value_int_create ( long long int const val ) {
+  if ( ( CHUNK_IMMEDIATE_MIN <= val ) && ( val <= CHUNK_IMMEDIATE_MAX ) ) {
+    return chunk_immediate_create ( CHUNK_TAG_INT , val ) ;
+  }
+  //  Allocation (chunk and state in one block)
+  chunk ch = VALUE_CHUNK_ALLOCATE ( int ) ;
+  //  Initialisation
+  ( ( value_int_state ) ( ch -> state ) ) -> copies_count = 1 ;
+  ( ( value_int_state ) ( ch -> state ) ) -> val = val ;
+  return ch ;
+}
+
+
+VALUE_IS_FULL( int )
 
 
 
@@ -16,6 +16,9 @@
  * \li '-' sign if negative (nothing for positive) followed by
  * \li sequence of digits.
  *
+ * A \c value_int is an immediate \c chunk whenever the integer fits in its payload, so that creating, copying and destroying it involves no allocation.
+ * Otherwise it is stored in an allocated state shared between copies.
+ *
  * assert is enforced.
  *
  * \author Jérôme DURAND-LOSE
@@ -28,5 +31,12 @@
 VALUE_DECLARE( int , long long int ) 
 
 
+/*!
+ * Class of the immediate \c value_int (see \link chunk_immediate_class \endlink).
+ * Integers are held as immediates (no allocation) unless they do not fit in the payload.
+ */
+extern chunk_struct const value_int_immediate_class ;
+
+
 # endif
 
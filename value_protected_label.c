@@ -22,6 +22,8 @@
  * \c value_protected_label are read and printed in the following form: \c '\\' followed by the label.
  * For example: \c \Bob and \c\in_34
  *
+ * The \c sstring given on creation belongs to the \c value: it is interned as a \link symbol\endlink and destroyed.
+ *
  * assert is enforced.
  *
  * \author Jérôme DURAND-LOSE
@@ -31,6 +33,77 @@
  */
 
 
-VALUE_DECLARE( protected_label , sstring ) 
+/*!
+ * The label is interned, only its symbol is kept.
+ */
+typedef struct {
+  unsigned int copies_count ;
+  symbol label ;
+} value_protected_label_state_struct ,
+  * value_protected_label_state ;
+
+
+/*!
+ * The \c sstring is not a copy (it is the name of the symbol).
+ */
+static basic_type value_protected_label_get_value ( chunk const ch ) {
+  return basic_type_pointer ( symbol_get_name ( ( ( value_protected_label_state ) ( ch -> state ) ) -> label ) ) ; 
+}
+
+
+static basic_type value_protected_label_print ( chunk const ch ,
+						FILE * const f ) {
+  fputc ( '\\' , f ) ;
+  sstring_print ( symbol_get_name ( ( ( value_protected_label_state ) ( ch -> state ) ) -> label ) , f ) ;
+  return basic_type_void ;
+}
+
+
+static basic_type value_protected_label_destroy ( chunk const ch ) {
+  if ( 1 == ( ( value_protected_label_state ) ( ch -> state ) ) -> copies_count -- ) {
+    VALUE_CHUNK_RELEASE ( protected_label , ch ) ;
+  }
+  return basic_type_void ;
+}
+
+
+static chunk value_protected_label_copy ( chunk const ch ) {
+  ( ( value_protected_label_state ) ( ch -> state ) ) -> copies_count ++ ;
+  return ch ; 
+}
+
+
+static const message_action value_protected_label_reactions [] = {
+  MESSAGE_ACTION__BASIC_VALUE ,
+  { NULL, NULL }
+} ;
+
+
+static const chunk_vtable value_protected_label_vtable = {
+  CHUNK_VTABLE__BASIC_VALUE( protected_label )
+} ;
+
+
+/*!
+ * The \c sstring is interned and then destroyed.
+ */
+chunk value_protected_label_create ( sstring const val ) {
+  assert ( NULL != val ) ;
+  assert ( ! sstring_is_empty ( val ) ) ;
+  //  Allocation (chunk and state in one block)
+  chunk ch = VALUE_CHUNK_ALLOCATE ( protected_label ) ;
+  //  Initialisation
+  ( ( value_protected_label_state ) ( ch -> state ) ) -> copies_count = 1 ;
+  ( ( value_protected_label_state ) ( ch -> state ) ) -> label = symbol_intern ( val ) ;
+  sstring_destroy ( val ) ;
+  return ch ;
+}
+
+
+VALUE_IS_FULL( protected_label )
 
 
+symbol value_protected_label_get_symbol ( chunk const ch ) {
+  assert ( value_is_protected_label ( ch ) ) ;
+  return ( ( value_protected_label_state ) ( ch -> state ) ) -> label ;
+}
@@ -3,6 +3,7 @@
 
 # include "value.h"
 # include "sstring.h"
+# include "symbol.h"
 
 # include "macro_value.h"
 
@@ -17,6 +18,8 @@
  * \c value_protected_label are read and printed in the following form: \c '\\' followed by the label.
  * For example: \c \Bob and \c\in_34
  *
+ * The \c sstring given on creation belongs to the \c value: it is interned as a \link symbol\endlink and destroyed.
+ *
  * assert is enforced.
  *
  * \author Jérôme DURAND-LOSE
@@ -29,4 +32,14 @@
 VALUE_DECLARE( protected_label , sstring ) 
 
 
+/*!
+ * Return the \c symbol of the label.
+ *
+ * \param ch \c chunk to query
+ * \pre \c ch must be a \c value_protected_label (assert-ed)
+ * \return the \c symbol of the label
+ */
+extern symbol value_protected_label_get_symbol ( chunk const ch ) ;
+
+
 # endif
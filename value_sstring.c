@@ -23,6 +23,12 @@
  *
  * There is \em no \em limit to the length of a string.
  *
+ * \c value_sstring is immutable so that copies share the same \c chunk (and \c sstring) through a reference count.
+ * Copying is thus O(1) whatever the length of the string.
+ * The \c sstring given on creation belongs to the \c value_sstring from now on: it is interned (see \link sstring_intern() \endlink) and destroyed.
+ * So that equal \c value_sstring's share the same \c sstring and are tested for equality by address.
+ * The last copy gives it back (see \link sstring_unintern() \endlink), so that the \c sstring's of released values do not accumulate.
+ *
  * assert is enforced.
  *
  * \author Jérôme DURAND-LOSE
@@ -32,6 +38,66 @@
  */
 
 
-VALUE_DECLARE ( sstring , sstring ) 
+/*!
+ * The interned \c sstring and the number of copies sharing it.
+ */
+typedef struct {
+  unsigned int copies_count ;
+  sstring ss ;
+} value_sstring_state_struct ,
+  * value_sstring_state ;
+
+
+static basic_type value_sstring_get_value ( chunk const ch ) {
+  return basic_type_pointer ( ( ( value_sstring_state ) ( ch -> state ) ) -> ss ) ;
+}
+
+
+static basic_type value_sstring_print ( chunk const ch ,
+					FILE * const f ) {
+  fputc ( '"' , f ) ;
+  sstring_print ( ( ( value_sstring_state ) ( ch -> state ) ) -> ss , f ) ;
+  fputc ( '"' , f ) ;
+  return basic_type_void ;
+}
+
+
+static basic_type value_sstring_destroy ( chunk const ch ) {
+  if ( 1 == ( ( value_sstring_state ) ( ch -> state ) ) -> copies_count -- ) {
+    sstring_unintern ( ( ( value_sstring_state ) ( ch -> state ) ) -> ss ) ;
+    VALUE_CHUNK_RELEASE ( sstring , ch ) ;
+  }
+  return basic_type_void ;
+}
+
+
+static chunk value_sstring_copy ( chunk const ch ) {
+  ( ( value_sstring_state ) ( ch -> state ) ) -> copies_count ++ ;
+  return ch ;
+}
+
+
+static const message_action value_sstring_reactions [] = {
+  MESSAGE_ACTION__BASIC_VALUE ,
+  { NULL, NULL }
+} ;
+
+
+static const chunk_vtable value_sstring_vtable = {
+  CHUNK_VTABLE__BASIC_VALUE( sstring )
+} ;
+
+
+chunk value_sstring_create ( sstring const ss ) {
+  assert ( NULL != ss ) ;
+  chunk ch = VALUE_CHUNK_ALLOCATE ( sstring ) ;
+  ( ( value_sstring_state ) ( ch -> state ) ) -> copies_count = 1 ;
+  ( ( value_sstring_state ) ( ch -> state ) ) -> ss = sstring_intern ( ss ) ;
+  sstring_destroy ( ss ) ;
+  return ch ;
+}
+
+
+VALUE_IS_FULL( sstring )
 
 
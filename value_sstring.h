@@ -17,6 +17,12 @@
  *
  * There is \em no \em limit to the length of a string.
  *
+ * \c value_sstring is immutable so that copies share the same \c chunk (and \c sstring) through a reference count.
+ * Copying is thus O(1) whatever the length of the string.
+ * The \c sstring given on creation belongs to the \c value_sstring from now on: it is interned (see \link sstring_intern() \endlink) and destroyed.
+ * So that equal \c value_sstring's share the same \c sstring and are tested for equality by address.
+ * The last copy gives it back (see \link sstring_unintern() \endlink), so that the \c sstring's of released values do not accumulate.
+ *
  * assert is enforced.
  *
  * \author Jérôme DURAND-LOSE